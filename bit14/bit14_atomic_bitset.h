@@ -0,0 +1,346 @@
+//bit14_atomic_bitset.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	bit14::atomic_bitset is a fixed size bitmap of slot indices that
+|||	threads claim and return without a lock. A set bit is a slot in use.
+|||
+|||		explicit atomic_bitset(std::size_t size);
+|||		atomic_bitset(std::size_t size, bool use_summary);
+|||		std::size_t acquire_first_free() noexcept;
+|||		std::size_t acquire_first_free(std::size_t start) noexcept;
+|||		std::size_t acquire_n(int k) noexcept;
+|||		std::size_t acquire_n(int k, std::size_t start) noexcept;
+|||		void release(std::size_t i) noexcept;
+|||		void release_n(std::size_t i, int k) noexcept;
+|||		bool test(std::size_t i) const noexcept;
+|||		std::size_t count() const noexcept;
+|||		std::size_t size() const noexcept;
+|||
+|||	acquire_first_free() picks a clear bit with bit14::countr_one and
+|||	claims it with fetch_or, retrying on the returned word when another
+|||	thread got there first. acquire_n() claims k contiguous bits inside
+|||	a single 64 bit word (1 <= k <= 64) with compare_exchange. Both
+|||	return atomic_bitset::npos when no free slot was found.
+|||
+|||	The overloads without a start slot begin the search at a per thread
+|||	position, so threads mostly claim bits in different cache lines.
+|||
+|||	With use_summary (the default from 4096 slots on) a second level
+|||	keeps one bit per word that is set while the word is full, and the
+|||	search skips full words 64 at a time with bit14::countr_zero. The
+|||	summary is only a hint: a search that finds nothing through it scans
+|||	the words themselves before giving up.
+|||
+|||	count() and test() are snapshots and may be stale by the time they
+|||	return when other threads are claiming or releasing slots.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <atomic>			//atomic
+#include <memory>			//unique_ptr
+#include <thread>			//this_thread::get_id
+#include <functional>		//hash
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+namespace detail
+{
+//Bit i of the result is set when bits i to i + k - 1 of free_bits are all set.
+inline uint64_t free_runs(uint64_t free_bits, const int k) noexcept
+{
+	for (int have = 1; have < k;)
+	{
+		const int shift = (k - have < have) ? k - have : have;
+		free_bits &= free_bits >> shift;
+		have += shift;
+	}
+
+	return free_bits;
+}
+
+//Spreads the search start of different threads over the bitmap.
+inline std::size_t thread_start_hint() noexcept
+{
+	static thread_local const std::size_t hint = static_cast<std::size_t>(
+		std::hash<std::thread::id>()(std::this_thread::get_id()) * 0x9E3779B97F4A7C15ull >> 16);
+	return hint;
+}
+} //end namespace detail
+
+class atomic_bitset
+{
+public:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	explicit atomic_bitset(const std::size_t size) : atomic_bitset(size, size >= 4096) {}
+
+	atomic_bitset(const std::size_t size, const bool use_summary)
+		: m_size(size), m_word_count((size + 63) / 64),
+		m_summary_count(use_summary ? (m_word_count + 63) / 64 : 0),
+		m_words(new std::atomic<uint64_t>[m_word_count ? m_word_count : 1]),
+		m_summary(new std::atomic<uint64_t>[m_summary_count ? m_summary_count : 1])
+	{
+		for (std::size_t i = 0; i < m_word_count; ++i)
+			m_words[i].store(0, std::memory_order_relaxed);
+
+		for (std::size_t i = 0; i < m_summary_count; ++i)
+			m_summary[i].store(0, std::memory_order_relaxed);
+
+		//Bits past the end stay claimed forever.
+		if (m_size % 64)
+			m_words[m_word_count - 1].store(~uint64_t{ 0 } << (m_size % 64), std::memory_order_relaxed);
+
+		if (m_summary_count && m_word_count % 64)
+			m_summary[m_summary_count - 1].store(~uint64_t{ 0 } << (m_word_count % 64), std::memory_order_relaxed);
+	}
+
+	atomic_bitset(const atomic_bitset&) = delete;
+	atomic_bitset& operator=(const atomic_bitset&) = delete;
+
+	std::size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool test(const std::size_t i) const noexcept
+	{
+		return (m_words[i / 64].load(std::memory_order_acquire) >> (i % 64)) & 1;
+	}
+
+	std::size_t count() const noexcept
+	{
+		std::size_t result = 0;
+
+		for (std::size_t i = 0; i < m_word_count; ++i)
+			result += static_cast<std::size_t>(bit14::popcount(m_words[i].load(std::memory_order_relaxed)));
+
+		return result - (m_word_count * 64 - m_size);
+	}
+
+	std::size_t acquire_first_free() noexcept
+	{
+		return acquire_first_free(detail::thread_start_hint() * 64);
+	}
+
+	std::size_t acquire_first_free(const std::size_t start) noexcept
+	{
+		return search(start, [this](const std::size_t word_index) noexcept
+		{
+			return claim_one(word_index);
+		});
+	}
+
+	std::size_t acquire_n(const int k) noexcept
+	{
+		return acquire_n(k, detail::thread_start_hint() * 64);
+	}
+
+	std::size_t acquire_n(const int k, const std::size_t start) noexcept
+	{
+		if (k <= 0 || k > 64)
+			return npos;
+
+		return search(start, [this, k](const std::size_t word_index) noexcept
+		{
+			return claim_run(word_index, k);
+		});
+	}
+
+	void release(const std::size_t i) noexcept
+	{
+		release_mask(i / 64, uint64_t{ 1 } << (i % 64));
+	}
+
+	//Releases bits i to i + k - 1, which must lie in one word as returned by acquire_n.
+	void release_n(const std::size_t i, const int k) noexcept
+	{
+		release_mask(i / 64, run_mask(k) << (i % 64));
+	}
+
+private:
+	static uint64_t run_mask(const int k) noexcept
+	{
+		return k >= 64 ? ~uint64_t{ 0 } : (uint64_t{ 1 } << k) - 1;
+	}
+
+	std::size_t claim_one(const std::size_t word_index) noexcept
+	{
+		std::atomic<uint64_t>& word = m_words[word_index];
+		uint64_t current = word.load(std::memory_order_relaxed);
+
+		while (current != ~uint64_t{ 0 })
+		{
+			const uint64_t bit = uint64_t{ 1 } << bit14::countr_one(current);
+			const uint64_t previous = word.fetch_or(bit, std::memory_order_acquire);
+
+			if (!(previous & bit))
+			{
+				if ((previous | bit) == ~uint64_t{ 0 })
+					mark_full(word_index);
+
+				return word_index * 64 + static_cast<std::size_t>(bit14::countr_zero(bit));
+			}
+
+			current = previous | bit;
+		}
+
+		return npos;
+	}
+
+	std::size_t claim_run(const std::size_t word_index, const int k) noexcept
+	{
+		std::atomic<uint64_t>& word = m_words[word_index];
+		uint64_t current = word.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			const uint64_t runs = detail::free_runs(~current, k);
+
+			if (runs == 0)
+				return npos;
+
+			const int first = bit14::countr_zero(runs);
+			const uint64_t claimed = current | (run_mask(k) << first);
+
+			if (word.compare_exchange_weak(current, claimed, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				if (claimed == ~uint64_t{ 0 })
+					mark_full(word_index);
+
+				return word_index * 64 + static_cast<std::size_t>(first);
+			}
+		}
+	}
+
+	void release_mask(const std::size_t word_index, const uint64_t mask) noexcept
+	{
+		const uint64_t previous = m_words[word_index].fetch_and(~mask, std::memory_order_seq_cst);
+
+		if (m_summary_count && previous == ~uint64_t{ 0 })
+			m_summary[word_index / 64].fetch_and(~(uint64_t{ 1 } << (word_index % 64)), std::memory_order_seq_cst);
+	}
+
+	//A release may slip in between filling the word and setting its summary bit,
+	//so the word is checked again and the bit withdrawn when it is no longer full.
+	void mark_full(const std::size_t word_index) noexcept
+	{
+		if (!m_summary_count)
+			return;
+
+		const uint64_t bit = uint64_t{ 1 } << (word_index % 64);
+		std::atomic<uint64_t>& summary = m_summary[word_index / 64];
+		summary.fetch_or(bit, std::memory_order_seq_cst);
+
+		if (m_words[word_index].load(std::memory_order_seq_cst) != ~uint64_t{ 0 })
+			summary.fetch_and(~bit, std::memory_order_seq_cst);
+	}
+
+	template <typename Claim>
+	std::size_t search(const std::size_t start, Claim claim) noexcept
+	{
+		if (m_word_count == 0)
+			return npos;
+
+		const std::size_t start_word = (start / 64) % m_word_count;
+
+		if (m_summary_count)
+		{
+			const std::size_t result = search_summary(start_word, claim);
+
+			if (result != npos)
+				return result;
+		}
+
+		for (std::size_t i = 0; i < m_word_count; ++i)
+		{
+			std::size_t word_index = start_word + i;
+
+			if (word_index >= m_word_count)
+				word_index -= m_word_count;
+
+			const std::size_t result = claim(word_index);
+
+			if (result != npos)
+				return result;
+		}
+
+		return npos;
+	}
+
+	template <typename Claim>
+	std::size_t search_summary(const std::size_t start_word, Claim& claim) noexcept
+	{
+		const std::size_t start_summary = start_word / 64;
+		const uint64_t start_mask = ~uint64_t{ 0 } << (start_word % 64);
+
+		//The first summary word is visited twice, from the start bit up and then below it.
+		for (std::size_t i = 0; i <= m_summary_count; ++i)
+		{
+			std::size_t summary_index = start_summary + i;
+
+			if (summary_index >= m_summary_count)
+				summary_index -= m_summary_count;
+
+			uint64_t candidates = ~m_summary[summary_index].load(std::memory_order_relaxed);
+
+			if (i == 0)
+				candidates &= start_mask;
+			else if (i == m_summary_count)
+				candidates &= ~start_mask;
+
+			while (candidates)
+			{
+				const std::size_t word_index = summary_index * 64 + static_cast<std::size_t>(bit14::countr_zero(candidates));
+				const std::size_t result = claim(word_index);
+
+				if (result != npos)
+					return result;
+
+				candidates &= candidates - 1;
+			}
+		}
+
+		return npos;
+	}
+
+	std::size_t m_size;
+	std::size_t m_word_count;
+	std::size_t m_summary_count;
+	std::unique_ptr<std::atomic<uint64_t>[]> m_words;
+	std::unique_ptr<std::atomic<uint64_t>[]> m_summary;
+};
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
@@ -0,0 +1,799 @@
+//bit14_bitpack.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	Fixed bit width packing of uint32_t and uint64_t integers in blocks
+|||	of bitpack_block (256) values. A block of B bit values occupies
+|||	exactly 32 * B bytes, i.e. B 256 bit vectors: value i goes to lane
+|||	i % lanes of the vector, where lanes is 8 for uint32_t and 4 for
+|||	uint64_t, and each lane is a little endian bit stream of its own.
+|||	Unpacking is then the same shift and mask on every lane, one AVX2
+|||	register or two SSE2 registers decode a row of lanes values.
+|||
+|||		template <int B, typename T>
+|||		T* pack_bits(const T* in, std::size_t blocks, T* out) noexcept;
+|||		template <int B, typename T>
+|||		const T* unpack_bits(const T* in, std::size_t blocks, T* out) noexcept;
+|||
+|||	B ranges over 0 to the width of T. Every B is its own fully
+|||	unrolled kernel with constant shifts and masks, the overloads
+|||	taking int bits as their first argument pick the kernel at run
+|||	time from a table. pack_bits() masks every value to B bits. Both
+|||	return the position after the packed words, packed_words() tells
+|||	how many words a number of blocks takes.
+|||
+|||	The frame of reference variants store value - reference and the
+|||	delta variants store value - previous, where previous is the value
+|||	one row (lanes values) earlier and the argument for the first row.
+|||	Strided deltas keep the prefix sum of unpack_bits_delta() one
+|||	vector add per row:
+|||
+|||		pack_bits_for<B>(in, blocks, reference, out);
+|||		unpack_bits_for<B>(in, blocks, reference, out);
+|||		pack_bits_delta<B>(in, blocks, previous, out);
+|||		unpack_bits_delta<B>(in, blocks, previous, out);
+|||
+|||	packed_bit_width(in, n) is the bit width of the largest of n values.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <type_traits>		//integral_constant
+#include <utility>			//integer_sequence
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+#if defined(BIT14_USING_SSE2) || defined(BIT14_USING_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace bit14
+{
+constexpr std::size_t bitpack_block = 256;
+
+namespace detail
+{
+template <typename T>
+using use_if_bitpack_type = typename use_if<is_bit14_32_bit_type<T>::value ||
+	is_bit14_64_bit_type<T>::value>::type;
+
+template <typename T>
+constexpr T bitpack_mask(const int bits) noexcept
+{
+	return bits == 0 ? T(0) : static_cast<T>(~T(0) >> (numeric_limits<T>::digits - bits));
+}
+
+//A row of lanes values, one per lane of the block.
+template <typename T>
+struct bitpack_scalar
+{
+	static constexpr int lanes = 32 / sizeof(T);
+
+	struct reg
+	{
+		T lane[lanes];
+	};
+
+	static reg load(const T* p) noexcept
+	{
+		reg result;
+
+		for (int i = 0; i < lanes; ++i)
+			result.lane[i] = p[i];
+
+		return result;
+	}
+
+	static void store(T* p, const reg v) noexcept
+	{
+		for (int i = 0; i < lanes; ++i)
+			p[i] = v.lane[i];
+	}
+
+	static reg set1(const T x) noexcept
+	{
+		reg result;
+
+		for (int i = 0; i < lanes; ++i)
+			result.lane[i] = x;
+
+		return result;
+	}
+
+	static reg add(reg a, const reg b) noexcept
+	{
+		for (int i = 0; i < lanes; ++i)
+			a.lane[i] = static_cast<T>(a.lane[i] + b.lane[i]);
+
+		return a;
+	}
+
+	static reg sub(reg a, const reg b) noexcept
+	{
+		for (int i = 0; i < lanes; ++i)
+			a.lane[i] = static_cast<T>(a.lane[i] - b.lane[i]);
+
+		return a;
+	}
+};
+
+#ifdef BIT14_USING_SSE2
+template <typename T, int Digits = numeric_limits<T>::digits>
+struct bitpack_sse2_lanes;
+
+template <typename T>
+struct bitpack_sse2_lanes<T, 32>
+{
+	static __m128i set1(const T x) noexcept
+	{
+		return _mm_set1_epi32(static_cast<int>(x));
+	}
+
+	template <int S>
+	static __m128i srl(const __m128i v) noexcept
+	{
+		return _mm_srli_epi32(v, S);
+	}
+
+	template <int S>
+	static __m128i sll(const __m128i v) noexcept
+	{
+		return _mm_slli_epi32(v, S);
+	}
+
+	static __m128i add(const __m128i a, const __m128i b) noexcept
+	{
+		return _mm_add_epi32(a, b);
+	}
+
+	static __m128i sub(const __m128i a, const __m128i b) noexcept
+	{
+		return _mm_sub_epi32(a, b);
+	}
+};
+
+template <typename T>
+struct bitpack_sse2_lanes<T, 64>
+{
+	static __m128i set1(const T x) noexcept
+	{
+		return _mm_set1_epi64x(static_cast<long long>(x));
+	}
+
+	template <int S>
+	static __m128i srl(const __m128i v) noexcept
+	{
+		return _mm_srli_epi64(v, S);
+	}
+
+	template <int S>
+	static __m128i sll(const __m128i v) noexcept
+	{
+		return _mm_slli_epi64(v, S);
+	}
+
+	static __m128i add(const __m128i a, const __m128i b) noexcept
+	{
+		return _mm_add_epi64(a, b);
+	}
+
+	static __m128i sub(const __m128i a, const __m128i b) noexcept
+	{
+		return _mm_sub_epi64(a, b);
+	}
+};
+
+//A row is 32 bytes, held as two 128 bit halves.
+template <typename T>
+struct bitpack_sse2
+{
+	using half = bitpack_sse2_lanes<T>;
+
+	struct reg
+	{
+		__m128i low;
+		__m128i high;
+	};
+
+	static reg load(const T* p) noexcept
+	{
+		const __m128i* const v = reinterpret_cast<const __m128i*>(p);
+		return { _mm_loadu_si128(v), _mm_loadu_si128(v + 1) };
+	}
+
+	static void store(T* p, const reg r) noexcept
+	{
+		__m128i* const v = reinterpret_cast<__m128i*>(p);
+		_mm_storeu_si128(v, r.low);
+		_mm_storeu_si128(v + 1, r.high);
+	}
+
+	static reg set1(const T x) noexcept
+	{
+		const __m128i v = half::set1(x);
+		return { v, v };
+	}
+
+	template <int S>
+	static reg srl(const reg r) noexcept
+	{
+		return { half::template srl<S>(r.low), half::template srl<S>(r.high) };
+	}
+
+	template <int S>
+	static reg sll(const reg r) noexcept
+	{
+		return { half::template sll<S>(r.low), half::template sll<S>(r.high) };
+	}
+
+	static reg and_bits(const reg a, const reg b) noexcept
+	{
+		return { _mm_and_si128(a.low, b.low), _mm_and_si128(a.high, b.high) };
+	}
+
+	static reg or_bits(const reg a, const reg b) noexcept
+	{
+		return { _mm_or_si128(a.low, b.low), _mm_or_si128(a.high, b.high) };
+	}
+
+	static reg add(const reg a, const reg b) noexcept
+	{
+		return { half::add(a.low, b.low), half::add(a.high, b.high) };
+	}
+
+	static reg sub(const reg a, const reg b) noexcept
+	{
+		return { half::sub(a.low, b.low), half::sub(a.high, b.high) };
+	}
+};
+#endif //end of #ifdef BIT14_USING_SSE2
+
+#ifdef BIT14_USING_AVX2
+template <typename T, int Digits = numeric_limits<T>::digits>
+struct bitpack_avx2_lanes;
+
+template <typename T>
+struct bitpack_avx2_lanes<T, 32>
+{
+	static __m256i set1(const T x) noexcept
+	{
+		return _mm256_set1_epi32(static_cast<int>(x));
+	}
+
+	template <int S>
+	static __m256i srl(const __m256i v) noexcept
+	{
+		return _mm256_srli_epi32(v, S);
+	}
+
+	template <int S>
+	static __m256i sll(const __m256i v) noexcept
+	{
+		return _mm256_slli_epi32(v, S);
+	}
+
+	static __m256i add(const __m256i a, const __m256i b) noexcept
+	{
+		return _mm256_add_epi32(a, b);
+	}
+
+	static __m256i sub(const __m256i a, const __m256i b) noexcept
+	{
+		return _mm256_sub_epi32(a, b);
+	}
+};
+
+template <typename T>
+struct bitpack_avx2_lanes<T, 64>
+{
+	static __m256i set1(const T x) noexcept
+	{
+		return _mm256_set1_epi64x(static_cast<long long>(x));
+	}
+
+	template <int S>
+	static __m256i srl(const __m256i v) noexcept
+	{
+		return _mm256_srli_epi64(v, S);
+	}
+
+	template <int S>
+	static __m256i sll(const __m256i v) noexcept
+	{
+		return _mm256_slli_epi64(v, S);
+	}
+
+	static __m256i add(const __m256i a, const __m256i b) noexcept
+	{
+		return _mm256_add_epi64(a, b);
+	}
+
+	static __m256i sub(const __m256i a, const __m256i b) noexcept
+	{
+		return _mm256_sub_epi64(a, b);
+	}
+};
+
+template <typename T>
+struct bitpack_avx2 : bitpack_avx2_lanes<T>
+{
+	using reg = __m256i;
+
+	static reg load(const T* p) noexcept
+	{
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+	}
+
+	static void store(T* p, const reg v) noexcept
+	{
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+	}
+
+	static reg and_bits(const reg a, const reg b) noexcept
+	{
+		return _mm256_and_si256(a, b);
+	}
+
+	static reg or_bits(const reg a, const reg b) noexcept
+	{
+		return _mm256_or_si256(a, b);
+	}
+};
+#endif //end of #ifdef BIT14_USING_AVX2
+
+//Value transforms applied to every row on the way in and out.
+template <typename Ops>
+struct bitpack_plain
+{
+	using reg = typename Ops::reg;
+
+	explicit bitpack_plain(const reg) noexcept {}
+
+	reg encode(const reg v) noexcept
+	{
+		return v;
+	}
+
+	reg decode(const reg v) noexcept
+	{
+		return v;
+	}
+};
+
+template <typename Ops>
+struct bitpack_frame
+{
+	using reg = typename Ops::reg;
+
+	explicit bitpack_frame(const reg reference) noexcept : m_reference(reference) {}
+
+	reg encode(const reg v) noexcept
+	{
+		return Ops::sub(v, m_reference);
+	}
+
+	reg decode(const reg v) noexcept
+	{
+		return Ops::add(v, m_reference);
+	}
+
+	reg m_reference;
+};
+
+template <typename Ops>
+struct bitpack_delta
+{
+	using reg = typename Ops::reg;
+
+	explicit bitpack_delta(const reg previous) noexcept : m_previous(previous) {}
+
+	reg encode(const reg v) noexcept
+	{
+		const reg delta = Ops::sub(v, m_previous);
+		m_previous = v;
+		return delta;
+	}
+
+	reg decode(const reg v) noexcept
+	{
+		m_previous = Ops::add(m_previous, v);
+		return m_previous;
+	}
+
+	reg m_previous;
+};
+
+//Row I of a block holds the bits [I * B, I * B + B) of every lane. Every
+//row is its own instantiation, so all shifts and branches are constants.
+template <typename T, int B, typename Ops>
+struct bitpack_kernel
+{
+	using reg = typename Ops::reg;
+	using done = std::true_type;
+	using more = std::false_type;
+
+	static constexpr int digits = numeric_limits<T>::digits;
+	static constexpr int lanes = 32 / sizeof(T);
+	static constexpr std::size_t packed_stride = static_cast<std::size_t>(lanes) * B;
+
+	template <int I>
+	struct row
+	{
+		static constexpr int word = I * B / digits;
+		static constexpr int shift = I * B % digits;
+		//0 when B is 0, 1 when the row sits in one word, 2 when it continues into the next.
+		using kind = std::integral_constant<int, B == 0 ? 0 : (shift + B > digits ? 2 : 1)>;
+		//0 when the word is still open, 1 when the row fills it, 2 when bits spill into the next.
+		using flush = std::integral_constant<int, shift + B < digits ? 0 : (shift + B == digits ? 1 : 2)>;
+	};
+
+	template <int I>
+	static reg extract(const T*, std::integral_constant<int, 0>) noexcept
+	{
+		return Ops::set1(0);
+	}
+
+	template <int I>
+	static reg extract(const T* in, std::integral_constant<int, 1>) noexcept
+	{
+		const reg v = Ops::template srl<row<I>::shift>(Ops::load(in + row<I>::word * lanes));
+		return Ops::and_bits(v, Ops::set1(bitpack_mask<T>(B)));
+	}
+
+	template <int I>
+	static reg extract(const T* in, std::integral_constant<int, 2>) noexcept
+	{
+		const reg low = Ops::template srl<row<I>::shift>(Ops::load(in + row<I>::word * lanes));
+		const reg high = Ops::template sll<digits - row<I>::shift>(Ops::load(in + (row<I>::word + 1) * lanes));
+		return Ops::and_bits(Ops::or_bits(low, high), Ops::set1(bitpack_mask<T>(B)));
+	}
+
+	template <int I, typename F>
+	static void unpack(const T*, T*, F&, done) noexcept {}
+
+	template <int I, typename F>
+	static void unpack(const T* in, T* out, F& transform, more) noexcept
+	{
+		Ops::store(out + I * lanes, transform.decode(extract<I>(in, typename row<I>::kind())));
+		unpack<I + 1>(in, out, transform, std::integral_constant<bool, I + 1 == digits>());
+	}
+
+	template <int I>
+	static reg accumulate(const reg, const reg v, std::true_type) noexcept
+	{
+		return v;
+	}
+
+	template <int I>
+	static reg accumulate(const reg acc, const reg v, std::false_type) noexcept
+	{
+		return Ops::or_bits(acc, Ops::template sll<row<I>::shift>(v));
+	}
+
+	template <int I>
+	static reg emit(T*, const reg acc, const reg, std::integral_constant<int, 0>) noexcept
+	{
+		return acc;
+	}
+
+	template <int I>
+	static reg emit(T* out, const reg acc, const reg, std::integral_constant<int, 1>) noexcept
+	{
+		Ops::store(out + row<I>::word * lanes, acc);
+		return Ops::set1(0);
+	}
+
+	template <int I>
+	static reg emit(T* out, const reg acc, const reg v, std::integral_constant<int, 2>) noexcept
+	{
+		Ops::store(out + row<I>::word * lanes, acc);
+		return Ops::template srl<digits - row<I>::shift>(v);
+	}
+
+	template <int I, typename F>
+	static void pack(const T*, T*, F&, reg, done) noexcept {}
+
+	template <int I, typename F>
+	static void pack(const T* in, T* out, F& transform, reg acc, more) noexcept
+	{
+		const reg v = Ops::and_bits(transform.encode(Ops::load(in + I * lanes)), Ops::set1(bitpack_mask<T>(B)));
+		acc = accumulate<I>(acc, v, std::integral_constant<bool, row<I>::shift == 0>());
+		acc = emit<I>(out, acc, v, typename row<I>::flush());
+		pack<I + 1>(in, out, transform, acc, std::integral_constant<bool, I + 1 == digits>());
+	}
+
+	template <typename F>
+	static const T* unpack_blocks(const T* in, std::size_t blocks, T* out, F& transform) noexcept
+	{
+		for (; blocks > 0; --blocks)
+		{
+			unpack<0>(in, out, transform, more());
+			in += packed_stride;
+			out += bitpack_block;
+		}
+
+		return in;
+	}
+
+	template <typename F>
+	static T* pack_blocks(const T* in, std::size_t blocks, T* out, F& transform) noexcept
+	{
+		for (; blocks > 0; --blocks)
+		{
+			pack<0>(in, out, transform, Ops::set1(0), more());
+			in += bitpack_block;
+			out += packed_stride;
+		}
+
+		return out;
+	}
+};
+
+//Without SIMD registers the rows are walked in a loop, one lane at a time.
+template <typename T, int B>
+struct bitpack_scalar_kernel
+{
+	using ops = bitpack_scalar<T>;
+	using reg = typename ops::reg;
+
+	static constexpr int digits = numeric_limits<T>::digits;
+	static constexpr int lanes = ops::lanes;
+	static constexpr std::size_t packed_stride = static_cast<std::size_t>(lanes) * B;
+
+	template <typename F>
+	static const T* unpack_blocks(const T* in, std::size_t blocks, T* out, F& transform) noexcept
+	{
+		for (; blocks > 0; --blocks)
+		{
+			for (int i = 0; i < digits; ++i)
+			{
+				const int word = i * B / digits;
+				const int shift = i * B % digits;
+				const int spill = (digits - shift) & (digits - 1);
+				reg v = ops::set1(0);
+
+				for (int lane = 0; lane < lanes && B != 0; ++lane)
+				{
+					T x = static_cast<T>(in[word * lanes + lane] >> shift);
+
+					if (shift + B > digits)
+						x |= static_cast<T>(in[(word + 1) * lanes + lane] << spill);
+
+					v.lane[lane] = x & bitpack_mask<T>(B);
+				}
+
+				ops::store(out + i * lanes, transform.decode(v));
+			}
+
+			in += packed_stride;
+			out += bitpack_block;
+		}
+
+		return in;
+	}
+
+	template <typename F>
+	static T* pack_blocks(const T* in, std::size_t blocks, T* out, F& transform) noexcept
+	{
+		for (; blocks > 0; --blocks)
+		{
+			for (std::size_t i = 0; i < packed_stride; ++i)
+				out[i] = 0;
+
+			for (int i = 0; i < digits; ++i)
+			{
+				const int word = i * B / digits;
+				const int shift = i * B % digits;
+				const int spill = (digits - shift) & (digits - 1);
+				const reg v = transform.encode(ops::load(in + i * lanes));
+
+				for (int lane = 0; lane < lanes && B != 0; ++lane)
+				{
+					const T x = v.lane[lane] & bitpack_mask<T>(B);
+					out[word * lanes + lane] |= static_cast<T>(x << shift);
+
+					if (shift + B > digits)
+						out[(word + 1) * lanes + lane] |= static_cast<T>(x >> spill);
+				}
+			}
+
+			in += bitpack_block;
+			out += packed_stride;
+		}
+
+		return out;
+	}
+};
+
+#if defined(BIT14_USING_AVX2)
+template <typename T>
+using bitpack_ops = bitpack_avx2<T>;
+
+template <typename T, int B>
+using bitpack_kernel_for = bitpack_kernel<T, B, bitpack_avx2<T>>;
+#elif defined(BIT14_USING_SSE2)
+template <typename T>
+using bitpack_ops = bitpack_sse2<T>;
+
+template <typename T, int B>
+using bitpack_kernel_for = bitpack_kernel<T, B, bitpack_sse2<T>>;
+#else
+template <typename T>
+using bitpack_ops = bitpack_scalar<T>;
+
+template <typename T, int B>
+using bitpack_kernel_for = bitpack_scalar_kernel<T, B>;
+#endif
+
+template <int B, typename T, template <typename> class Mode>
+const T* bitpack_unpack(const T* in, const std::size_t blocks, T* out, const T param) noexcept
+{
+	static_assert(B >= 0 && B <= numeric_limits<T>::digits,
+		"bit14::unpack_bits requires a bit width between 0 and the width of the integer type.\n");
+	Mode<bitpack_ops<T>> transform(bitpack_ops<T>::set1(param));
+	return bitpack_kernel_for<T, B>::unpack_blocks(in, blocks, out, transform);
+}
+
+template <int B, typename T, template <typename> class Mode>
+T* bitpack_pack(const T* in, const std::size_t blocks, T* out, const T param) noexcept
+{
+	static_assert(B >= 0 && B <= numeric_limits<T>::digits,
+		"bit14::pack_bits requires a bit width between 0 and the width of the integer type.\n");
+	Mode<bitpack_ops<T>> transform(bitpack_ops<T>::set1(param));
+	return bitpack_kernel_for<T, B>::pack_blocks(in, blocks, out, transform);
+}
+
+template <typename T, template <typename> class Mode>
+struct bitpack_table
+{
+	using unpack_fn = const T* (*)(const T*, std::size_t, T*, T);
+	using pack_fn = T* (*)(const T*, std::size_t, T*, T);
+	using widths = std::make_integer_sequence<int, numeric_limits<T>::digits + 1>;
+
+	template <int... B>
+	static const unpack_fn* unpackers(std::integer_sequence<int, B...>) noexcept
+	{
+		static const unpack_fn table[] = { &bitpack_unpack<B, T, Mode>... };
+		return table;
+	}
+
+	template <int... B>
+	static const pack_fn* packers(std::integer_sequence<int, B...>) noexcept
+	{
+		static const pack_fn table[] = { &bitpack_pack<B, T, Mode>... };
+		return table;
+	}
+
+	static const T* unpack(const int bits, const T* in, const std::size_t blocks, T* out, const T param) noexcept
+	{
+		assert(bits >= 0 && bits <= numeric_limits<T>::digits);
+		return unpackers(widths())[bits](in, blocks, out, param);
+	}
+
+	static T* pack(const int bits, const T* in, const std::size_t blocks, T* out, const T param) noexcept
+	{
+		assert(bits >= 0 && bits <= numeric_limits<T>::digits);
+		return packers(widths())[bits](in, blocks, out, param);
+	}
+};
+} //end namespace detail
+
+template <typename T, detail::use_if_bitpack_type<T> = true>
+constexpr std::size_t packed_words(const int bits, const std::size_t blocks) noexcept
+{
+	return blocks * (32 / sizeof(T)) * static_cast<std::size_t>(bits);
+}
+
+template <typename T, use_if_bit14_type<T> = true>
+int packed_bit_width(const T* in, const std::size_t n) noexcept
+{
+	T bits = 0;
+
+	for (std::size_t i = 0; i < n; ++i)
+		bits |= in[i];
+
+	return bit14::bit_width(bits);
+}
+
+template <int B, typename T, detail::use_if_bitpack_type<T> = true>
+T* pack_bits(const T* in, const std::size_t blocks, T* out) noexcept
+{
+	return detail::bitpack_pack<B, T, detail::bitpack_plain>(in, blocks, out, 0);
+}
+
+template <int B, typename T, detail::use_if_bitpack_type<T> = true>
+const T* unpack_bits(const T* in, const std::size_t blocks, T* out) noexcept
+{
+	return detail::bitpack_unpack<B, T, detail::bitpack_plain>(in, blocks, out, 0);
+}
+
+template <int B, typename T, detail::use_if_bitpack_type<T> = true>
+T* pack_bits_for(const T* in, const std::size_t blocks, const T reference, T* out) noexcept
+{
+	return detail::bitpack_pack<B, T, detail::bitpack_frame>(in, blocks, out, reference);
+}
+
+template <int B, typename T, detail::use_if_bitpack_type<T> = true>
+const T* unpack_bits_for(const T* in, const std::size_t blocks, const T reference, T* out) noexcept
+{
+	return detail::bitpack_unpack<B, T, detail::bitpack_frame>(in, blocks, out, reference);
+}
+
+template <int B, typename T, detail::use_if_bitpack_type<T> = true>
+T* pack_bits_delta(const T* in, const std::size_t blocks, const T previous, T* out) noexcept
+{
+	return detail::bitpack_pack<B, T, detail::bitpack_delta>(in, blocks, out, previous);
+}
+
+template <int B, typename T, detail::use_if_bitpack_type<T> = true>
+const T* unpack_bits_delta(const T* in, const std::size_t blocks, const T previous, T* out) noexcept
+{
+	return detail::bitpack_unpack<B, T, detail::bitpack_delta>(in, blocks, out, previous);
+}
+
+template <typename T, detail::use_if_bitpack_type<T> = true>
+T* pack_bits(const int bits, const T* in, const std::size_t blocks, T* out) noexcept
+{
+	return detail::bitpack_table<T, detail::bitpack_plain>::pack(bits, in, blocks, out, 0);
+}
+
+template <typename T, detail::use_if_bitpack_type<T> = true>
+const T* unpack_bits(const int bits, const T* in, const std::size_t blocks, T* out) noexcept
+{
+	return detail::bitpack_table<T, detail::bitpack_plain>::unpack(bits, in, blocks, out, 0);
+}
+
+template <typename T, detail::use_if_bitpack_type<T> = true>
+T* pack_bits_for(const int bits, const T* in, const std::size_t blocks, const T reference, T* out) noexcept
+{
+	return detail::bitpack_table<T, detail::bitpack_frame>::pack(bits, in, blocks, out, reference);
+}
+
+template <typename T, detail::use_if_bitpack_type<T> = true>
+const T* unpack_bits_for(const int bits, const T* in, const std::size_t blocks, const T reference, T* out) noexcept
+{
+	return detail::bitpack_table<T, detail::bitpack_frame>::unpack(bits, in, blocks, out, reference);
+}
+
+template <typename T, detail::use_if_bitpack_type<T> = true>
+T* pack_bits_delta(const int bits, const T* in, const std::size_t blocks, const T previous, T* out) noexcept
+{
+	return detail::bitpack_table<T, detail::bitpack_delta>::pack(bits, in, blocks, out, previous);
+}
+
+template <typename T, detail::use_if_bitpack_type<T> = true>
+const T* unpack_bits_delta(const int bits, const T* in, const std::size_t blocks, const T previous, T* out) noexcept
+{
+	return detail::bitpack_table<T, detail::bitpack_delta>::unpack(bits, in, blocks, out, previous);
+}
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
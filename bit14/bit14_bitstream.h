@@ -0,0 +1,334 @@
+//bit14_bitstream.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	Bit streams over byte buffers, in one of two bit orders:
+|||
+|||		bit14::lsb_first	bits fill each byte from bit 0 up (deflate)
+|||		bit14::msb_first	bits fill each byte from bit 7 down (jpeg, h.264)
+|||
+|||	bit14::bit_reader<Order> keeps a 64 bit buffer of at least 56 valid
+|||	bits after refill(). A refill is one unaligned 8 byte load, byte
+|||	swapped for msb_first, merged below the bits still buffered, with
+|||	the read position advanced by whole bytes. Only the last 8 bytes
+|||	of the input take a separate, zero padded path.
+|||
+|||		bit_reader(const void* data, std::size_t size) noexcept;
+|||		void refill() noexcept;
+|||		uint64_t peek(int n) const noexcept;		//0 <= n <= 56
+|||		void consume(int n) noexcept;
+|||		uint64_t read(int n) noexcept;			//refill, peek, consume
+|||		uint64_t window() const noexcept;
+|||		int available() const noexcept;
+|||		std::size_t position() const noexcept;		//bits consumed
+|||		bool overrun() const noexcept;
+|||
+|||	peek() and consume() are straight line code and leave refilling
+|||	to the caller, so a decoder may take up to 56 bits per refill.
+|||	window() is the raw buffer, its next bit is bit 0 for lsb_first
+|||	and bit 63 for msb_first. Bits past the end of the input read as
+|||	zero and set overrun().
+|||
+|||	bit14::bit_writer<Order> collects bits in a 64 bit buffer and
+|||	stores it as one word whenever it fills up:
+|||
+|||		bit_writer(void* data, std::size_t size) noexcept;
+|||		void write(uint64_t value, int n) noexcept;	//0 <= n <= 64, value < 2^n
+|||		std::size_t finish() noexcept;			//bytes written
+|||		std::size_t position() const noexcept;		//bits written
+|||		bool overflow() const noexcept;
+|||
+|||	finish() writes the partial last word, padding its last byte with
+|||	zeros. Bits that do not fit in size bytes are dropped, set
+|||	overflow() and are not counted by position().
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <cstring>			//memcpy
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+struct lsb_first
+{
+	static uint64_t load(const unsigned char* p) noexcept
+	{
+		return detail::load_le<uint64_t>(p);
+	}
+
+	static void store(unsigned char* p, const uint64_t word) noexcept
+	{
+		detail::store_le(p, word);
+	}
+
+	//count is below 64, the bits of word land above the count bits buffered.
+	static uint64_t merge(const uint64_t buffer, const uint64_t word, const int count) noexcept
+	{
+		return buffer | (word << count);
+	}
+
+	static uint64_t peek(const uint64_t buffer, const int n) noexcept
+	{
+		return buffer & ((uint64_t{ 1 } << n) - 1);
+	}
+
+	static uint64_t drop(const uint64_t buffer, const int n) noexcept
+	{
+		return buffer >> n;
+	}
+};
+
+struct msb_first
+{
+	static uint64_t load(const unsigned char* p) noexcept
+	{
+		return detail::load_be<uint64_t>(p);
+	}
+
+	static void store(unsigned char* p, const uint64_t word) noexcept
+	{
+		detail::store_be(p, word);
+	}
+
+	static uint64_t merge(const uint64_t buffer, const uint64_t word, const int count) noexcept
+	{
+		return buffer | (word >> count);
+	}
+
+	//Split in two so that n == 0 does not shift by 64.
+	static uint64_t peek(const uint64_t buffer, const int n) noexcept
+	{
+		return (buffer >> 1) >> (63 - n);
+	}
+
+	static uint64_t drop(const uint64_t buffer, const int n) noexcept
+	{
+		return buffer << n;
+	}
+};
+
+template <typename Order>
+class bit_reader
+{
+public:
+	bit_reader(const void* data, const std::size_t size) noexcept
+		: m_data(static_cast<const unsigned char*>(data)), m_size(size), m_next(0), m_buffer(0), m_count(0)
+	{
+		refill();
+	}
+
+	void refill() noexcept
+	{
+		if (m_next + 8 <= m_size)
+			merge(Order::load(m_data + m_next));
+		else
+			refill_tail();
+	}
+
+	uint64_t peek(const int n) const noexcept
+	{
+		return Order::peek(m_buffer, n);
+	}
+
+	void consume(const int n) noexcept
+	{
+		m_buffer = Order::drop(m_buffer, n);
+		m_count -= n;
+	}
+
+	uint64_t read(const int n) noexcept
+	{
+		refill();
+		const uint64_t value = peek(n);
+		consume(n);
+		return value;
+	}
+
+	uint64_t window() const noexcept
+	{
+		return m_buffer;
+	}
+
+	int available() const noexcept
+	{
+		return m_count;
+	}
+
+	std::size_t position() const noexcept
+	{
+		return m_next * 8 - static_cast<std::size_t>(m_count);
+	}
+
+	bool overrun() const noexcept
+	{
+		return position() > m_size * 8;
+	}
+
+private:
+	//Buffered bits above m_count already hold the following bytes, so the
+	//overlapping load ORs in the same values and only whole bytes advance.
+	void merge(const uint64_t word) noexcept
+	{
+		m_buffer = Order::merge(m_buffer, word, m_count);
+		m_next += static_cast<std::size_t>((63 - m_count) >> 3);
+		m_count |= 56;
+	}
+
+	void refill_tail() noexcept
+	{
+		unsigned char tail[8] = {};
+
+		if (m_next < m_size)
+			std::memcpy(tail, m_data + m_next, m_size - m_next);
+
+		merge(Order::load(tail));
+	}
+
+	const unsigned char* m_data;
+	std::size_t m_size;
+	std::size_t m_next;
+	uint64_t m_buffer;
+	int m_count;
+};
+
+template <typename Order>
+class bit_writer
+{
+public:
+	bit_writer(void* data, const std::size_t size) noexcept
+		: m_begin(static_cast<unsigned char*>(data)), m_next(m_begin), m_end(m_begin + size),
+		m_buffer(0), m_count(0), m_overflow(false)
+	{
+	}
+
+	void write(const uint64_t value, const int n) noexcept
+	{
+		write(value, n, Order());
+	}
+
+	std::size_t finish() noexcept
+	{
+		if (m_count > 0)
+		{
+			store(aligned(Order()), (m_count + 7) / 8);
+			m_buffer = 0;
+			m_count = 0;
+		}
+
+		return static_cast<std::size_t>(m_next - m_begin);
+	}
+
+	std::size_t position() const noexcept
+	{
+		return static_cast<std::size_t>(m_next - m_begin) * 8 + static_cast<std::size_t>(m_count);
+	}
+
+	bool overflow() const noexcept
+	{
+		return m_overflow;
+	}
+
+private:
+	void write(const uint64_t value, const int n, lsb_first) noexcept
+	{
+		m_buffer |= value << m_count;
+		const int total = m_count + n;
+
+		if (total < 64)
+		{
+			m_count = total;
+			return;
+		}
+
+		store(m_buffer, 8);
+		m_count = total - 64;
+		m_buffer = m_count ? value >> (n - m_count) : 0;
+	}
+
+	//The low m_count bits of m_buffer are pending, anything above them is shifted out before a store.
+	void write(const uint64_t value, const int n, msb_first) noexcept
+	{
+		const int total = m_count + n;
+
+		if (total < 64)
+		{
+			m_buffer = (m_buffer << n) | value;
+			m_count = total;
+			return;
+		}
+
+		const int room = 64 - m_count;
+		const uint64_t word = (m_count == 0) ? value : (m_buffer << room) | (value >> (n - room));
+		store(word, 8);
+		m_count = total - 64;
+		m_buffer = value;
+	}
+
+	uint64_t aligned(lsb_first) const noexcept
+	{
+		return m_buffer;
+	}
+
+	uint64_t aligned(msb_first) const noexcept
+	{
+		return m_buffer << (64 - m_count);
+	}
+
+	void store(const uint64_t word, const int bytes) noexcept
+	{
+		if (m_end - m_next >= 8)
+		{
+			Order::store(m_next, word);
+			m_next += bytes;
+			return;
+		}
+
+		unsigned char tail[8];
+		Order::store(tail, word);
+		const std::ptrdiff_t room = m_end - m_next;
+		const int kept = room < bytes ? static_cast<int>(room) : bytes;
+		std::memcpy(m_next, tail, static_cast<std::size_t>(kept));
+		m_next += kept;
+		m_overflow = m_overflow || kept < bytes;
+	}
+
+	unsigned char* m_begin;
+	unsigned char* m_next;
+	unsigned char* m_end;
+	uint64_t m_buffer;
+	int m_count;
+	bool m_overflow;
+};
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
@@ -0,0 +1,277 @@
+//bit14_blocked_bloom.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	bit14::blocked_bloom is a Bloom filter over uint64_t keys in which
+|||	every key lives in a single 64 byte block, one cache line, so a
+|||	lookup costs one memory access instead of k:
+|||
+|||		explicit blocked_bloom(std::size_t capacity, std::size_t bits_per_key = 12);
+|||		void insert(uint64_t key) noexcept;
+|||		bool contains(uint64_t key) const noexcept;
+|||		void contains(const uint64_t* keys, std::size_t n, uint64_t* out_mask) const noexcept;
+|||		double false_positive_rate(std::size_t inserted) const noexcept;
+|||		void clear() noexcept;
+|||		std::size_t block_count() const noexcept;
+|||		std::size_t size_in_bytes() const noexcept;
+|||
+|||	Keys are mixed once with a 64 bit finalizer. The high 32 bits pick
+|||	the block by multiply and shift, and the key sets one bit in each
+|||	of the 8 words of the block (k = 8). The 8 bit positions are 6 bit
+|||	fields of the hash remixed with bit14::rotl and an odd multiplier,
+|||	so they do not repeat the bits that chose the block.
+|||
+|||	With AVX2 the 8 single bit masks are built with variable shifts and
+|||	a probe is an AND NOT / test over the two halves of the block.
+|||	The batch contains() hashes and prefetches 64 keys at a time and then
+|||	probes them, setting bit i % 64 of out_mask[i / 64] for every key
+|||	that may be present. false_positive_rate() estimates the rate after
+|||	the given number of distinct insertions, allowing for the Poisson
+|||	spread of keys over blocks.
+|||
+|||	The filter needs at most 2^32 blocks (256 GiB).
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <cstdint>			//uintptr_t
+#include <cmath>			//exp, log, lgamma, pow, sqrt, floor
+#include <memory>			//unique_ptr
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+#if defined(BIT14_USING_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace bit14
+{
+namespace detail
+{
+inline uint64_t bloom_mix(uint64_t key) noexcept
+{
+	key ^= key >> 33;
+	key *= 0xFF51AFD7ED558CCDull;
+	key ^= key >> 33;
+	key *= 0xC4CEB9FE1A85EC53ull;
+	key ^= key >> 33;
+	return key;
+}
+
+//Source of the 8 bit positions, the fields start at bit 16 so the low,
+//least mixed bits of the product are never used.
+inline uint64_t bloom_bit_source(const uint64_t hash) noexcept
+{
+	return bit14::rotl(hash, 27) * 0x9E3779B97F4A7C15ull;
+}
+
+constexpr int bloom_field_shift(const int word) noexcept
+{
+	return 16 + 6 * word;
+}
+} //end namespace detail
+
+class blocked_bloom
+{
+public:
+	static constexpr std::size_t block_words = 8;
+
+	explicit blocked_bloom(const std::size_t capacity, const std::size_t bits_per_key = 12)
+		: m_blocks(block_count_for(capacity, bits_per_key)),
+		m_storage(new uint64_t[m_blocks * block_words + block_words - 1])
+	{
+		const std::size_t misalignment = (reinterpret_cast<std::uintptr_t>(m_storage.get()) / 8) % block_words;
+		m_offset = (block_words - misalignment) % block_words;
+		clear();
+	}
+
+	blocked_bloom(const blocked_bloom&) = delete;
+	blocked_bloom& operator=(const blocked_bloom&) = delete;
+	blocked_bloom(blocked_bloom&&) = default;
+	blocked_bloom& operator=(blocked_bloom&&) = default;
+
+	std::size_t block_count() const noexcept
+	{
+		return m_blocks;
+	}
+
+	std::size_t size_in_bytes() const noexcept
+	{
+		return m_blocks * block_words * sizeof(uint64_t);
+	}
+
+	void clear() noexcept
+	{
+		uint64_t* const words = block(0);
+
+		for (std::size_t i = 0; i < m_blocks * block_words; ++i)
+			words[i] = 0;
+	}
+
+	void insert(const uint64_t key) noexcept
+	{
+		const uint64_t hash = detail::bloom_mix(key);
+		set_bits(block(block_index(hash)), detail::bloom_bit_source(hash));
+	}
+
+	bool contains(const uint64_t key) const noexcept
+	{
+		const uint64_t hash = detail::bloom_mix(key);
+		return test_bits(block(block_index(hash)), detail::bloom_bit_source(hash));
+	}
+
+	void contains(const uint64_t* const keys, const std::size_t n, uint64_t* const out_mask) const noexcept
+	{
+		const uint64_t* blocks[64];
+		uint64_t sources[64];
+
+		for (std::size_t first = 0; first < n; first += 64)
+		{
+			const std::size_t batch = (n - first < 64) ? n - first : 64;
+
+			for (std::size_t i = 0; i < batch; ++i)
+			{
+				const uint64_t hash = detail::bloom_mix(keys[first + i]);
+				blocks[i] = block(block_index(hash));
+				sources[i] = detail::bloom_bit_source(hash);
+				detail::prefetch(blocks[i]);
+			}
+
+			uint64_t mask = 0;
+
+			for (std::size_t i = 0; i < batch; ++i)
+				mask |= static_cast<uint64_t>(test_bits(blocks[i], sources[i])) << i;
+
+			out_mask[first / 64] = mask;
+		}
+	}
+
+	//Sum over the Poisson distributed block loads c of P(c) * (1 - (63 / 64)^c)^8.
+	double false_positive_rate(const std::size_t inserted) const noexcept
+	{
+		const double load = static_cast<double>(inserted) / static_cast<double>(m_blocks);
+
+		if (load == 0)
+			return 0;
+
+		const double spread = 10 * std::sqrt(load) + 10;
+		const double first = (load > spread) ? std::floor(load - spread) : 0;
+		const double last = load + spread;
+		const double log_load = std::log(load);
+		const double log_clear = std::log(63.0 / 64.0);
+		double rate = 0;
+
+		for (double c = first; c <= last; ++c)
+		{
+			const double probability = std::exp(c * log_load - load - std::lgamma(c + 1));
+			const double word_hit = 1 - std::exp(c * log_clear);
+			rate += probability * std::pow(word_hit, static_cast<double>(block_words));
+		}
+
+		return rate;
+	}
+
+private:
+	static std::size_t block_count_for(const std::size_t capacity, const std::size_t bits_per_key) noexcept
+	{
+		const std::size_t bits = capacity * bits_per_key;
+		const std::size_t blocks = (bits + 511) / 512;
+		return blocks ? blocks : 1;
+	}
+
+	std::size_t block_index(const uint64_t hash) const noexcept
+	{
+		return static_cast<std::size_t>(((hash >> 32) * m_blocks) >> 32);
+	}
+
+	uint64_t* block(const std::size_t index) const noexcept
+	{
+		return m_storage.get() + m_offset + index * block_words;
+	}
+
+#if defined(BIT14_USING_AVX2)
+	//Masks with one bit for words 0 to 3 (low) and 4 to 7 (high).
+	static void bit_masks(const uint64_t source, __m256i& low, __m256i& high) noexcept
+	{
+		const __m256i value = _mm256_set1_epi64x(static_cast<long long>(source));
+		const __m256i field = _mm256_set1_epi64x(63);
+		const __m256i one = _mm256_set1_epi64x(1);
+		const __m256i low_shifts = _mm256_setr_epi64x(detail::bloom_field_shift(0), detail::bloom_field_shift(1),
+			detail::bloom_field_shift(2), detail::bloom_field_shift(3));
+		const __m256i high_shifts = _mm256_setr_epi64x(detail::bloom_field_shift(4), detail::bloom_field_shift(5),
+			detail::bloom_field_shift(6), detail::bloom_field_shift(7));
+		low = _mm256_sllv_epi64(one, _mm256_and_si256(_mm256_srlv_epi64(value, low_shifts), field));
+		high = _mm256_sllv_epi64(one, _mm256_and_si256(_mm256_srlv_epi64(value, high_shifts), field));
+	}
+
+	static void set_bits(uint64_t* const words, const uint64_t source) noexcept
+	{
+		__m256i low, high;
+		bit_masks(source, low, high);
+		__m256i* const halves = reinterpret_cast<__m256i*>(words);
+		_mm256_store_si256(halves, _mm256_or_si256(_mm256_load_si256(halves), low));
+		_mm256_store_si256(halves + 1, _mm256_or_si256(_mm256_load_si256(halves + 1), high));
+	}
+
+	static bool test_bits(const uint64_t* const words, const uint64_t source) noexcept
+	{
+		__m256i low, high;
+		bit_masks(source, low, high);
+		const __m256i* const halves = reinterpret_cast<const __m256i*>(words);
+		const __m256i missing = _mm256_or_si256(_mm256_andnot_si256(_mm256_load_si256(halves), low),
+			_mm256_andnot_si256(_mm256_load_si256(halves + 1), high));
+		return _mm256_testz_si256(missing, missing) != 0;
+	}
+#else
+	static void set_bits(uint64_t* const words, const uint64_t source) noexcept
+	{
+		for (std::size_t w = 0; w < block_words; ++w)
+			words[w] |= uint64_t{ 1 } << ((source >> detail::bloom_field_shift(static_cast<int>(w))) & 63);
+	}
+
+	static bool test_bits(const uint64_t* const words, const uint64_t source) noexcept
+	{
+		uint64_t found = 1;
+
+		for (std::size_t w = 0; w < block_words; ++w)
+			found &= words[w] >> ((source >> detail::bloom_field_shift(static_cast<int>(w))) & 63);
+
+		return found & 1;
+	}
+#endif
+
+	std::size_t m_blocks;
+	std::size_t m_offset;
+	std::unique_ptr<uint64_t[]> m_storage;
+};
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
@@ -0,0 +1,228 @@
+//bit14_buddy_allocator.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	bit14::buddy_allocator manages 2^max_order units (pages, extents)
+|||	in power of two blocks. A block of order k covers 2^k units and
+|||	starts at a multiple of 2^k, its buddy is the neighbour whose block
+|||	index differs in the lowest bit only, block ^ 1.
+|||
+|||	Every order keeps a bitmap of its free blocks with the same layered
+|||	summary words as bit14::bit_priority_set, and one more word holds a
+|||	bit per order that still has a free block. allocate() picks the
+|||	smallest usable order with bit14::countr_zero over that mask, takes
+|||	the lowest free block of it and splits it down, deallocate() merges
+|||	with free buddies on the way up. Both are O(log N) and never
+|||	allocate memory after construction.
+|||
+|||		explicit buddy_allocator(int max_order);
+|||		std::size_t allocate(int order) noexcept;		//first unit of the block
+|||		void deallocate(std::size_t offset, int order) noexcept;
+|||		static int order_for(std::size_t units) noexcept;	//bit_width(units - 1)
+|||		bool is_free(std::size_t offset, int order) const noexcept;
+|||		uint64_t order_mask() const noexcept;
+|||		std::size_t free_units() const noexcept;
+|||		int max_order() const noexcept;
+|||
+|||	allocate() returns buddy_allocator::npos when no block of the order
+|||	or above is free. deallocate() must get the offset and order of a
+|||	block returned by allocate().
+=========================================================================
+=========================================================================*/
+
+#include <cassert>			//assert
+#include <cstddef>			//size_t
+#include <vector>			//vector
+#include "bit14.h"
+#include "bit14_priority_set.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+class buddy_allocator
+{
+public:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	explicit buddy_allocator(const int max_order)
+		: m_max_order(max_order), m_order_mask(0), m_free_units(0)
+	{
+		assert(max_order >= 0 && max_order < 64);
+		std::size_t total_words = 0;
+
+		for (int order = 0; order <= max_order; ++order)
+		{
+			std::size_t bits = std::size_t{ 1 } << (max_order - order);
+			m_levels[order] = static_cast<int>(detail::summary_levels(bits));
+
+			for (int level = 0; level < m_levels[order]; ++level)
+			{
+				m_offsets[order][level] = total_words;
+				total_words += detail::summary_words(bits);
+				bits = detail::summary_words(bits);
+			}
+		}
+
+		m_words.assign(total_words, 0);
+		insert(max_order, 0);
+		m_free_units = std::size_t{ 1 } << max_order;
+	}
+
+	static int order_for(const std::size_t units) noexcept
+	{
+		return bit14::bit_width(units - (units != 0));
+	}
+
+	int max_order() const noexcept
+	{
+		return m_max_order;
+	}
+
+	uint64_t order_mask() const noexcept
+	{
+		return m_order_mask;
+	}
+
+	std::size_t free_units() const noexcept
+	{
+		return m_free_units;
+	}
+
+	bool is_free(const std::size_t offset, const int order) const noexcept
+	{
+		const std::size_t block = offset >> order;
+		return (m_words[m_offsets[order][0] + block / 64] >> (block % 64)) & 1;
+	}
+
+	std::size_t allocate(int order) noexcept
+	{
+		if (order < 0 || order > m_max_order)
+			return npos;
+
+		const uint64_t usable = m_order_mask & (~uint64_t{ 0 } << order);
+
+		if (usable == 0)
+			return npos;
+
+		int from = bit14::countr_zero(usable);
+		std::size_t block = lowest(from);
+		erase(from, block);
+
+		//Keep the lower half at every split, the upper half becomes a free buddy.
+		while (from > order)
+		{
+			--from;
+			block *= 2;
+			insert(from, block ^ 1);
+		}
+
+		m_free_units -= std::size_t{ 1 } << order;
+		return block << order;
+	}
+
+	void deallocate(const std::size_t offset, int order) noexcept
+	{
+		std::size_t block = offset >> order;
+		m_free_units += std::size_t{ 1 } << order;
+
+		while (order < m_max_order && contains(order, block ^ 1))
+		{
+			erase(order, block ^ 1);
+			block >>= 1;
+			++order;
+		}
+
+		insert(order, block);
+	}
+
+private:
+	//2^63 blocks of order 0 need 11 levels of 64 bit words.
+	static constexpr int max_levels = 11;
+
+	bool contains(const int order, const std::size_t block) const noexcept
+	{
+		return (m_words[m_offsets[order][0] + block / 64] >> (block % 64)) & 1;
+	}
+
+	void insert(const int order, std::size_t block) noexcept
+	{
+		for (int level = 0; level < m_levels[order]; ++level)
+		{
+			uint64_t& word = m_words[m_offsets[order][level] + block / 64];
+			const bool was_empty = (word == 0);
+			word |= uint64_t{ 1 } << (block % 64);
+
+			if (!was_empty)
+				return;
+
+			block /= 64;
+		}
+
+		m_order_mask |= uint64_t{ 1 } << order;
+	}
+
+	void erase(const int order, std::size_t block) noexcept
+	{
+		for (int level = 0; level < m_levels[order]; ++level)
+		{
+			uint64_t& word = m_words[m_offsets[order][level] + block / 64];
+			word &= ~(uint64_t{ 1 } << (block % 64));
+
+			if (word != 0)
+				return;
+
+			block /= 64;
+		}
+
+		m_order_mask &= ~(uint64_t{ 1 } << order);
+	}
+
+	//Requires the order to have a free block, see m_order_mask.
+	std::size_t lowest(const int order) const noexcept
+	{
+		std::size_t block = 0;
+
+		for (int level = m_levels[order] - 1; level >= 0; --level)
+			block = block * 64 + bit14::countr_zero(m_words[m_offsets[order][level] + block]);
+
+		return block;
+	}
+
+	int m_max_order;
+	uint64_t m_order_mask;
+	std::size_t m_free_units;
+	int m_levels[64];
+	std::size_t m_offsets[64][max_levels];
+	std::vector<uint64_t> m_words;
+};
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
@@ -0,0 +1,473 @@
+//bit14_byte_scan.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	memchr class byte scanning. Each function returns the index of the
+|||	first byte in data[0, n) that satisfies it, or n when none does:
+|||
+|||		std::size_t bit14::find_byte(const void* data, std::size_t n,
+|||			unsigned char byte) noexcept;
+|||
+|||		template <std::size_t N>
+|||		std::size_t bit14::find_any_of(const void* data, std::size_t n,
+|||			const unsigned char (&needles)[N]) noexcept;
+|||
+|||		std::size_t bit14::find_first_not(const void* data, std::size_t n,
+|||			unsigned char byte) noexcept;
+|||
+|||	find_any_of accepts 1 to 16 needles. With SSSE3 any byte set is
+|||	matched exactly with a pshufb lookup on each nibble.
+|||
+|||	Blocks are compared with SSE2 or AVX2 and reduced with movemask,
+|||	otherwise with SWAR over 64 bit words. The position comes from
+|||	bit14::countr_zero of the block mask either way. All loads are
+|||	aligned to the block width, so the first and last block may read
+|||	bytes outside [data, data + n) but never outside the aligned blocks
+|||	holding data[0] and data[n - 1], and so never touch another page.
+|||	Memory checkers such as AddressSanitizer may still report those reads.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <cstdint>			//uintptr_t
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+#if defined(BIT14_USING_SSE2) || defined(BIT14_USING_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace bit14
+{
+namespace detail
+{
+//Keeps the mask bits of the first count bytes of a block.
+template <int Shift>
+uint64_t keep_low_bytes(const uint64_t mask, const std::size_t count) noexcept
+{
+	const std::size_t bits = count << Shift;
+	return bits >= 64 ? mask : mask & ((uint64_t{ 1 } << bits) - 1);
+}
+
+template <typename Scanner>
+std::size_t scan_bytes(const void* data, const std::size_t n, const Scanner& scanner) noexcept
+{
+	constexpr std::size_t width = Scanner::width;
+	constexpr int shift = Scanner::shift;
+
+	if (n == 0)
+		return 0;
+
+	const unsigned char* first = static_cast<const unsigned char*>(data);
+	const std::size_t head = reinterpret_cast<std::uintptr_t>(first) & (width - 1);
+	const unsigned char* block = first - head;
+	uint64_t mask = scanner.match(block) >> (head << shift);
+	std::size_t start = width - head;
+
+	if (start >= n)
+		mask = keep_low_bytes<shift>(mask, n);
+
+	if (mask)
+		return static_cast<std::size_t>(bit14::countr_zero(mask) >> shift);
+
+	block += width;
+
+	//Four blocks per iteration, only the first one holding a match is decoded.
+	for (; start + 4 * width <= n; start += 4 * width, block += 4 * width)
+	{
+		const uint64_t mask_0 = scanner.match(block);
+		const uint64_t mask_1 = scanner.match(block + width);
+		const uint64_t mask_2 = scanner.match(block + 2 * width);
+		const uint64_t mask_3 = scanner.match(block + 3 * width);
+
+		if ((mask_0 | mask_1 | mask_2 | mask_3) == 0)
+			continue;
+
+		if (mask_0)
+			return start + static_cast<std::size_t>(bit14::countr_zero(mask_0) >> shift);
+		if (mask_1)
+			return start + width + static_cast<std::size_t>(bit14::countr_zero(mask_1) >> shift);
+		if (mask_2)
+			return start + 2 * width + static_cast<std::size_t>(bit14::countr_zero(mask_2) >> shift);
+
+		return start + 3 * width + static_cast<std::size_t>(bit14::countr_zero(mask_3) >> shift);
+	}
+
+	for (; start < n; start += width, block += width)
+	{
+		mask = keep_low_bytes<shift>(scanner.match(block), n - start);
+
+		if (mask)
+			return start + static_cast<std::size_t>(bit14::countr_zero(mask) >> shift);
+	}
+
+	return n;
+}
+
+/*======================================================
+||	SWAR scanners, one mask bit per byte at bit 8i + 7
+======================================================*/
+
+constexpr uint64_t scan_lsbs = 0x0101010101010101ull;
+constexpr uint64_t scan_msbs = 0x8080808080808080ull;
+
+class swar_find_byte
+{
+public:
+	static constexpr std::size_t width = 8;
+	static constexpr int shift = 3;
+
+	explicit swar_find_byte(const unsigned char byte) noexcept : m_pattern(scan_lsbs * byte) {}
+
+	uint64_t match(const unsigned char* block) const noexcept
+	{
+		return has_zero_byte(load_le<uint64_t>(block) ^ m_pattern);
+	}
+
+private:
+	uint64_t m_pattern;
+};
+
+class swar_find_first_not
+{
+public:
+	static constexpr std::size_t width = 8;
+	static constexpr int shift = 3;
+
+	explicit swar_find_first_not(const unsigned char byte) noexcept : m_pattern(scan_lsbs * byte) {}
+
+	uint64_t match(const unsigned char* block) const noexcept
+	{
+		return ~has_zero_byte(load_le<uint64_t>(block) ^ m_pattern) & scan_msbs;
+	}
+
+private:
+	uint64_t m_pattern;
+};
+
+template <std::size_t N>
+class swar_find_any_of
+{
+public:
+	static constexpr std::size_t width = 8;
+	static constexpr int shift = 3;
+
+	explicit swar_find_any_of(const unsigned char (&needles)[N]) noexcept
+	{
+		for (std::size_t i = 0; i < N; ++i)
+			m_patterns[i] = scan_lsbs * needles[i];
+	}
+
+	uint64_t match(const unsigned char* block) const noexcept
+	{
+		const uint64_t word = load_le<uint64_t>(block);
+		uint64_t mask = 0;
+
+		for (std::size_t i = 0; i < N; ++i)
+			mask |= has_zero_byte(word ^ m_patterns[i]);
+
+		return mask;
+	}
+
+private:
+	uint64_t m_patterns[N];
+};
+
+/*=========================================================
+||	Vector scanners, one mask bit per byte from movemask
+=========================================================*/
+
+#if defined(BIT14_USING_SSE2)
+struct sse2_bytes
+{
+	using vector = __m128i;
+	static constexpr std::size_t width = 16;
+	static constexpr uint64_t full = 0xFFFF;
+
+	static vector load(const unsigned char* block) noexcept
+	{
+		return _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+	}
+
+	static vector set1(const unsigned char byte) noexcept
+	{
+		return _mm_set1_epi8(static_cast<char>(byte));
+	}
+
+	static vector cmpeq(const vector a, const vector b) noexcept
+	{
+		return _mm_cmpeq_epi8(a, b);
+	}
+
+	static uint64_t movemask(const vector m) noexcept
+	{
+		return static_cast<uint32_t>(_mm_movemask_epi8(m));
+	}
+
+#ifdef BIT14_USING_SSSE3
+	static vector table(const unsigned char (&bytes)[16]) noexcept
+	{
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+	}
+
+	static vector lookup(const vector table, const vector nibbles) noexcept
+	{
+		return _mm_shuffle_epi8(table, nibbles);
+	}
+
+	static vector high_nibbles(const vector x) noexcept
+	{
+		return _mm_and_si128(_mm_srli_epi16(x, 4), _mm_set1_epi8(0x0F));
+	}
+
+	static vector low_nibbles(const vector x) noexcept
+	{
+		return _mm_and_si128(x, _mm_set1_epi8(0x0F));
+	}
+
+	static vector and_(const vector a, const vector b) noexcept
+	{
+		return _mm_and_si128(a, b);
+	}
+
+	static vector or_(const vector a, const vector b) noexcept
+	{
+		return _mm_or_si128(a, b);
+	}
+
+	static vector zero() noexcept
+	{
+		return _mm_setzero_si128();
+	}
+#endif //end of #ifdef BIT14_USING_SSSE3
+};
+#endif //end of #if defined(BIT14_USING_SSE2)
+
+#if defined(BIT14_USING_AVX2)
+struct avx2_bytes
+{
+	using vector = __m256i;
+	static constexpr std::size_t width = 32;
+	static constexpr uint64_t full = 0xFFFFFFFF;
+
+	static vector load(const unsigned char* block) noexcept
+	{
+		return _mm256_load_si256(reinterpret_cast<const __m256i*>(block));
+	}
+
+	static vector set1(const unsigned char byte) noexcept
+	{
+		return _mm256_set1_epi8(static_cast<char>(byte));
+	}
+
+	static vector cmpeq(const vector a, const vector b) noexcept
+	{
+		return _mm256_cmpeq_epi8(a, b);
+	}
+
+	static uint64_t movemask(const vector m) noexcept
+	{
+		return static_cast<uint32_t>(_mm256_movemask_epi8(m));
+	}
+
+	//pshufb looks up within each 128 bit lane, so the table is repeated in both.
+	static vector table(const unsigned char (&bytes)[16]) noexcept
+	{
+		return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes)));
+	}
+
+	static vector lookup(const vector table, const vector nibbles) noexcept
+	{
+		return _mm256_shuffle_epi8(table, nibbles);
+	}
+
+	static vector high_nibbles(const vector x) noexcept
+	{
+		return _mm256_and_si256(_mm256_srli_epi16(x, 4), _mm256_set1_epi8(0x0F));
+	}
+
+	static vector low_nibbles(const vector x) noexcept
+	{
+		return _mm256_and_si256(x, _mm256_set1_epi8(0x0F));
+	}
+
+	static vector and_(const vector a, const vector b) noexcept
+	{
+		return _mm256_and_si256(a, b);
+	}
+
+	static vector or_(const vector a, const vector b) noexcept
+	{
+		return _mm256_or_si256(a, b);
+	}
+
+	static vector zero() noexcept
+	{
+		return _mm256_setzero_si256();
+	}
+};
+#endif //end of #if defined(BIT14_USING_AVX2)
+
+template <typename Isa>
+class vector_find_byte
+{
+public:
+	static constexpr std::size_t width = Isa::width;
+	static constexpr int shift = 0;
+
+	explicit vector_find_byte(const unsigned char byte) noexcept : m_pattern(Isa::set1(byte)) {}
+
+	uint64_t match(const unsigned char* block) const noexcept
+	{
+		return Isa::movemask(Isa::cmpeq(Isa::load(block), m_pattern));
+	}
+
+private:
+	typename Isa::vector m_pattern;
+};
+
+template <typename Isa>
+class vector_find_first_not
+{
+public:
+	static constexpr std::size_t width = Isa::width;
+	static constexpr int shift = 0;
+
+	explicit vector_find_first_not(const unsigned char byte) noexcept : m_pattern(Isa::set1(byte)) {}
+
+	uint64_t match(const unsigned char* block) const noexcept
+	{
+		return ~Isa::movemask(Isa::cmpeq(Isa::load(block), m_pattern)) & Isa::full;
+	}
+
+private:
+	typename Isa::vector m_pattern;
+};
+
+/*=======================================================================
+||	Byte c belongs to the set when bit (c >> 4) % 8 is set in both
+||	low_table[c & 15] and high_bits[c >> 4] of the same table pair.
+||	High nibbles 0-7 use the first pair and 8-15 the second, so every
+||	high nibble owns its own bit and any set of bytes matches exactly.
+=======================================================================*/
+template <typename Isa>
+class vector_find_any_of
+{
+public:
+	static constexpr std::size_t width = Isa::width;
+	static constexpr int shift = 0;
+
+	template <std::size_t N>
+	explicit vector_find_any_of(const unsigned char (&needles)[N]) noexcept
+	{
+		unsigned char low_tables[2][16] = {};
+		unsigned char high_tables[2][16] = {};
+
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			const int high = needles[i] >> 4;
+			const int low = needles[i] & 0x0F;
+			low_tables[high >> 3][low] |= static_cast<unsigned char>(1u << (high & 7));
+		}
+
+		for (int high = 0; high < 16; ++high)
+			high_tables[high >> 3][high] = static_cast<unsigned char>(1u << (high & 7));
+
+		m_low_first = Isa::table(low_tables[0]);
+		m_low_second = Isa::table(low_tables[1]);
+		m_high_first = Isa::table(high_tables[0]);
+		m_high_second = Isa::table(high_tables[1]);
+	}
+
+	uint64_t match(const unsigned char* block) const noexcept
+	{
+		const typename Isa::vector x = Isa::load(block);
+		const typename Isa::vector low = Isa::low_nibbles(x);
+		const typename Isa::vector high = Isa::high_nibbles(x);
+		const typename Isa::vector first = Isa::and_(Isa::lookup(m_low_first, low),
+			Isa::lookup(m_high_first, high));
+		const typename Isa::vector second = Isa::and_(Isa::lookup(m_low_second, low),
+			Isa::lookup(m_high_second, high));
+		const typename Isa::vector misses = Isa::cmpeq(Isa::or_(first, second), Isa::zero());
+		return ~Isa::movemask(misses) & Isa::full;
+	}
+
+private:
+	typename Isa::vector m_low_first;
+	typename Isa::vector m_low_second;
+	typename Isa::vector m_high_first;
+	typename Isa::vector m_high_second;
+};
+
+#if defined(BIT14_USING_AVX2)
+using find_byte_scanner = vector_find_byte<avx2_bytes>;
+using find_first_not_scanner = vector_find_first_not<avx2_bytes>;
+#elif defined(BIT14_USING_SSE2)
+using find_byte_scanner = vector_find_byte<sse2_bytes>;
+using find_first_not_scanner = vector_find_first_not<sse2_bytes>;
+#else
+using find_byte_scanner = swar_find_byte;
+using find_first_not_scanner = swar_find_first_not;
+#endif
+
+#if defined(BIT14_USING_AVX2)
+template <std::size_t N>
+using find_any_of_scanner = vector_find_any_of<avx2_bytes>;
+#elif defined(BIT14_USING_SSSE3)
+template <std::size_t N>
+using find_any_of_scanner = vector_find_any_of<sse2_bytes>;
+#else
+template <std::size_t N>
+using find_any_of_scanner = swar_find_any_of<N>;
+#endif
+} //end namespace detail
+
+inline std::size_t find_byte(const void* data, const std::size_t n, const unsigned char byte) noexcept
+{
+	return detail::scan_bytes(data, n, detail::find_byte_scanner(byte));
+}
+
+template <std::size_t N>
+std::size_t find_any_of(const void* data, const std::size_t n, const unsigned char (&needles)[N]) noexcept
+{
+	static_assert(N >= 1 && N <= 16,
+		"bit14::find_any_of supports between 1 and 16 needle bytes.\n");
+
+	return detail::scan_bytes(data, n, detail::find_any_of_scanner<N>(needles));
+}
+
+inline std::size_t find_first_not(const void* data, const std::size_t n, const unsigned char byte) noexcept
+{
+	return detail::scan_bytes(data, n, detail::find_first_not_scanner(byte));
+}
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
@@ -0,0 +1,387 @@
+//bit14_charconv.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	Decimal integer conversion in the style of std::to_chars.
+|||
+|||		template <typename T>
+|||		int bit14::ilog10(T value) noexcept;	//floor(log10(value)), -1 for 0
+|||
+|||		template <typename T>
+|||		bit14::to_chars_result bit14::to_chars(char* first, char* last, T value) noexcept;
+|||
+|||	ilog10() takes an unsigned integer type. It estimates the number of
+|||	decimal digits from bit14::bit_width(value) * log10(2) and corrects
+|||	the estimate with one compare against a table of powers of ten, so
+|||	no division loop is needed.
+|||
+|||	to_chars() formats any integer type in base 10. The exact length is
+|||	known up front from ilog10(), the digits are then written from the
+|||	end two at a time out of a 200 byte table of digit pairs. 64 bit
+|||	values are first split into 8 digit chunks so the inner loop only
+|||	divides 32 bit numbers. Like std::to_chars, the output is not null
+|||	terminated and a range that is too short yields
+|||	std::errc::value_too_large with ptr == last.
+|||
+|||	Decimal parsing in the style of std::from_chars.
+|||
+|||		template <typename T>
+|||		bit14::from_chars_result bit14::parse_uint(const char* first, const char* last, T& value) noexcept;
+|||
+|||		template <typename T>
+|||		bit14::from_chars_result bit14::parse_int(const char* first, const char* last, T& value) noexcept;
+|||
+|||	parse_uint() takes an unsigned and parse_int() a signed integer type,
+|||	the latter accepts a leading '-'. Both consume the longest run of
+|||	digits, then return std::errc::invalid_argument with ptr == first when
+|||	there is none, or std::errc::result_out_of_range with ptr past the
+|||	digits and value untouched when the number does not fit T. Overflow
+|||	is detected exactly, whatever the number of leading zeros.
+|||
+|||	The digit run is measured 8 bytes at a time: the bytes are loaded as
+|||	a little endian word, a SWAR test marks every byte that is not a
+|||	digit and bit14::countr_zero of that mask gives the run length. With
+|||	SSE2 or AVX2 the scan takes 16 or 32 bytes per step instead. Eight
+|||	digits are combined with three multiply and shift steps, with SSE4.1
+|||	sixteen digits are combined at once with maddubs / madd.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <system_error>		//errc
+#include <type_traits>		//make_unsigned, is_signed
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+#if defined(BIT14_USING_SSE2) || defined(BIT14_USING_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace bit14
+{
+struct to_chars_result
+{
+	char* ptr;
+	std::errc ec;
+};
+
+struct from_chars_result
+{
+	const char* ptr;
+	std::errc ec;
+};
+
+namespace detail
+{
+constexpr uint64_t powers_of_10[20] =
+{
+	1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+	1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+	100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+	1000000000000000000ull, 10000000000000000000ull
+};
+
+constexpr char digit_pairs[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+//Writes value, which has digits digits, so that it ends at end.
+inline void write_digits(char* end, uint32_t value, int digits) noexcept
+{
+	while (digits >= 2)
+	{
+		const char* const pair = &digit_pairs[2 * (value % 100)];
+		value /= 100;
+		*--end = pair[1];
+		*--end = pair[0];
+		digits -= 2;
+	}
+
+	if (digits)
+		*--end = static_cast<char>('0' + value);
+}
+} //end namespace detail
+
+template <typename T, use_if_bit14_type<T> = true>
+int ilog10(const T value) noexcept
+{
+	//1233 / 4096 is just above log10(2).
+	const int estimate = (bit14::bit_width(value) * 1233) >> 12;
+	return estimate - (static_cast<uint64_t>(value) < detail::powers_of_10[estimate]);
+}
+
+template <typename T, use_if_integral<T> = true>
+to_chars_result to_chars(char* first, char* const last, const T value) noexcept
+{
+	using U = typename std::make_unsigned<T>::type;
+	const bool negative = std::is_signed<T>::value && value < 0;
+	uint64_t magnitude = negative ? static_cast<uint64_t>(static_cast<U>(U(0) - static_cast<U>(value))) :
+		static_cast<uint64_t>(value);
+	const int digits = (magnitude == 0) ? 1 : bit14::ilog10(magnitude) + 1;
+
+	if (last - first < digits + negative)
+		return { last, std::errc::value_too_large };
+
+	if (negative)
+		*first++ = '-';
+
+	char* const end = first + digits;
+	char* chunk_end = end;
+	int remaining = digits;
+
+	while (remaining > 8)
+	{
+		const uint32_t chunk = static_cast<uint32_t>(magnitude % 100000000);
+		magnitude /= 100000000;
+		detail::write_digits(chunk_end, chunk, 8);
+		chunk_end -= 8;
+		remaining -= 8;
+	}
+
+	detail::write_digits(chunk_end, static_cast<uint32_t>(magnitude), remaining);
+	return { end, std::errc() };
+}
+namespace detail
+{
+//Little endian load of the count (0 to 7) bytes at p, zero padded.
+inline uint64_t load_le_partial(const char* const p, const std::size_t count) noexcept
+{
+	if (count >= 4)
+	{
+		const uint64_t low = detail::load_le<uint32_t>(p);
+		const uint64_t high = detail::load_le<uint32_t>(p + count - 4);
+		return low | (high << (8 * (count - 4)));
+	}
+
+	if (count >= 2)
+	{
+		const uint64_t low = detail::load_le<uint16_t>(p);
+		const uint64_t high = detail::load_le<uint16_t>(p + count - 2);
+		return low | (high << (8 * (count - 2)));
+	}
+
+	return count ? static_cast<unsigned char>(*p) : 0;
+}
+
+//Up to 8 bytes at p, zero padded past last.
+inline uint64_t load_digit_chunk(const char* const p, const char* const last) noexcept
+{
+	return (last - p >= 8) ? detail::load_le<uint64_t>(p) : load_le_partial(p, static_cast<std::size_t>(last - p));
+}
+
+//Sets the high bit of every byte that is not an ASCII digit.
+inline uint64_t swar_non_digits(const uint64_t chunk) noexcept
+{
+	constexpr uint64_t low7 = 0x7F7F7F7F7F7F7F7Full;
+	const uint64_t offset = chunk ^ 0x3030303030303030ull;
+	return (((offset & low7) + 0x7676767676767676ull) | offset) & 0x8080808080808080ull;
+}
+
+inline std::size_t count_digits(const char* const first, const char* const last) noexcept
+{
+	const char* p = first;
+
+#if defined(BIT14_USING_AVX2)
+	for (; last - p >= 32; p += 32)
+	{
+		const __m256i offset = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), _mm256_set1_epi8('0'));
+		const __m256i digits = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8(9)), offset);
+		const uint32_t non_digits = ~static_cast<uint32_t>(_mm256_movemask_epi8(digits));
+
+		if (non_digits)
+			return static_cast<std::size_t>(p - first) + static_cast<std::size_t>(bit14::countr_zero(non_digits));
+	}
+#elif defined(BIT14_USING_SSE2)
+	for (; last - p >= 16; p += 16)
+	{
+		const __m128i offset = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+		const __m128i digits = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(9)), offset);
+		const uint32_t non_digits = ~static_cast<uint32_t>(_mm_movemask_epi8(digits)) & 0xFFFF;
+
+		if (non_digits)
+			return static_cast<std::size_t>(p - first) + static_cast<std::size_t>(bit14::countr_zero(non_digits));
+	}
+#endif
+
+	for (; last - p >= 8; p += 8)
+	{
+		const uint64_t non_digits = swar_non_digits(detail::load_le<uint64_t>(p));
+
+		if (non_digits)
+			return static_cast<std::size_t>(p - first) + static_cast<std::size_t>(bit14::countr_zero(non_digits) >> 3);
+	}
+
+	//The zero padding of the last partial chunk counts as a non digit.
+	const uint64_t non_digits = swar_non_digits(load_le_partial(p, static_cast<std::size_t>(last - p)));
+	return static_cast<std::size_t>(p - first) + static_cast<std::size_t>(bit14::countr_zero(non_digits) >> 3);
+}
+
+//Value of the first count (1 to 8) digit bytes of a little endian chunk.
+inline uint64_t combine_digits8(uint64_t chunk, const std::size_t count) noexcept
+{
+	//Bytes past the digits only borrow into higher bytes, which the shift drops.
+	chunk = (chunk - 0x3030303030303030ull) << (8 * (8 - count));
+	chunk = ((chunk & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+	chunk = ((chunk & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+	return ((chunk & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32;
+}
+
+#ifdef BIT14_USING_SSE4_1
+inline uint64_t parse_digits16(const char* const p) noexcept
+{
+	const __m128i digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+	const __m128i pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+	const __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+	const __m128i packed = _mm_packus_epi32(quads, quads);
+	const __m128i octets = _mm_madd_epi16(packed, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+	const uint64_t high = static_cast<uint32_t>(_mm_cvtsi128_si32(octets));
+	const uint64_t low = static_cast<uint32_t>(_mm_extract_epi32(octets, 1));
+	return high * 100000000 + low;
+}
+#endif
+
+//Parses the digit run at first as a number no larger than limit.
+inline from_chars_result parse_decimal(const char* const first, const char* const last,
+	const uint64_t limit, uint64_t& value) noexcept
+{
+	//Numbers of up to 7 digits are handled from the first chunk alone.
+	const uint64_t head = load_digit_chunk(first, last);
+	const uint64_t head_non_digits = swar_non_digits(head);
+
+	if (head_non_digits)
+	{
+		const std::size_t count = static_cast<std::size_t>(bit14::countr_zero(head_non_digits) >> 3);
+
+		if (count == 0)
+			return { first, std::errc::invalid_argument };
+
+		const uint64_t result = combine_digits8(head, count);
+
+		if (result > limit)
+			return { first + count, std::errc::result_out_of_range };
+
+		value = result;
+		return { first + count, std::errc() };
+	}
+
+	const char* const end = first + count_digits(first, last);
+
+	const char* p = first;
+
+	while (p != end - 1 && *p == '0')
+		++p;
+
+	const std::size_t significant = static_cast<std::size_t>(end - p);
+
+	if (significant > 20)
+		return { end, std::errc::result_out_of_range };
+
+	//The 20th digit of a 64 bit number is checked for overflow on its own.
+	const char* const exact_end = (significant == 20) ? end - 1 : end;
+	uint64_t result = 0;
+
+#ifdef BIT14_USING_SSE4_1
+	if (exact_end - p >= 16)
+	{
+		result = parse_digits16(p);
+		p += 16;
+	}
+#endif
+
+	for (; exact_end - p >= 8; p += 8)
+		result = result * 100000000 + combine_digits8(detail::load_le<uint64_t>(p), 8);
+
+	const std::size_t rest = static_cast<std::size_t>(exact_end - p);
+
+	if (rest)
+	{
+		result = result * powers_of_10[rest] + combine_digits8(load_digit_chunk(p, last), rest);
+		p += rest;
+	}
+
+	if (significant == 20)
+	{
+		const uint64_t digit = static_cast<uint64_t>(*p - '0');
+
+		if (result > (~uint64_t{ 0 } - digit) / 10)
+			return { end, std::errc::result_out_of_range };
+
+		result = result * 10 + digit;
+	}
+
+	if (result > limit)
+		return { end, std::errc::result_out_of_range };
+
+	value = result;
+	return { end, std::errc() };
+}
+} //end namespace detail
+
+template <typename T, use_if_bit14_type<T> = true>
+from_chars_result parse_uint(const char* const first, const char* const last, T& value) noexcept
+{
+	uint64_t result;
+	const from_chars_result parsed = detail::parse_decimal(first, last, numeric_limits<T>::max(), result);
+
+	if (parsed.ec == std::errc())
+		value = static_cast<T>(result);
+
+	return parsed;
+}
+
+template <typename T, typename detail::use_if<std::is_integral<T>::value && std::is_signed<T>::value>::type = true>
+from_chars_result parse_int(const char* const first, const char* const last, T& value) noexcept
+{
+	using U = typename std::make_unsigned<T>::type;
+	const bool negative = (first != last && *first == '-');
+	const uint64_t limit = static_cast<uint64_t>(numeric_limits<T>::max()) + negative;
+	uint64_t result;
+	const from_chars_result parsed = detail::parse_decimal(first + negative, last, limit, result);
+
+	if (parsed.ec == std::errc::invalid_argument)
+		return { first, parsed.ec };
+
+	if (parsed.ec == std::errc())
+		value = static_cast<T>(negative ? static_cast<U>(U(0) - static_cast<U>(result)) : static_cast<U>(result));
+
+	return parsed;
+}
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
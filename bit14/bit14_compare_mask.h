@@ -0,0 +1,602 @@
+//bit14_compare_mask.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	bit14::compare_to_mask compares every element of a column against
+|||	one constant (or the closed range [lo, hi] for compare_op::between)
+|||	and writes the results as a bitmap: bit (i % 64) of mask_out[i / 64]
+|||	is set when column[i] matches. mask_out must hold (n + 63) / 64 words,
+|||	unused bits of the last word are cleared. The number of matching
+|||	elements is returned, counted with bit14::popcount while each word
+|||	is still in a register.
+|||
+|||		template <compare_op Op, typename T>
+|||		std::size_t bit14::compare_to_mask(const T* column, std::size_t n,
+|||			T lo, T hi, uint64_t* mask_out) noexcept;
+|||
+|||		template <compare_op Op, typename T>
+|||		std::size_t bit14::compare_to_mask(const T* column, std::size_t n,
+|||			T value, uint64_t* mask_out) noexcept;
+|||
+|||	T may be any 8, 16, 32 or 64 bit integer, float or double.
+|||	hi is only read by compare_op::between. Comparisons against NaN
+|||	follow the scalar operators, so only compare_op::not_equal matches.
+|||	With AVX-512 (F + BW) mask registers are used, with AVX2 vector
+|||	compares are packed with movemask, otherwise a scalar loop is used.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <type_traits>		//integral_constant, is_integral, is_signed, is_floating_point
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+#if defined(BIT14_USING_AVX2) || defined(BIT14_USING_AVX512)
+#include <immintrin.h>
+#endif
+
+namespace bit14
+{
+enum class compare_op
+{
+	equal,
+	not_equal,
+	less,
+	less_equal,
+	greater,
+	greater_equal,
+	between
+};
+
+namespace detail
+{
+template <compare_op Op>
+using compare_op_tag = std::integral_constant<compare_op, Op>;
+
+template <typename T>
+bool compare_scalar(const T x, const T lo, const T, compare_op_tag<compare_op::equal>) noexcept
+{
+	return x == lo;
+}
+
+template <typename T>
+bool compare_scalar(const T x, const T lo, const T, compare_op_tag<compare_op::not_equal>) noexcept
+{
+	return x != lo;
+}
+
+template <typename T>
+bool compare_scalar(const T x, const T lo, const T, compare_op_tag<compare_op::less>) noexcept
+{
+	return x < lo;
+}
+
+template <typename T>
+bool compare_scalar(const T x, const T lo, const T, compare_op_tag<compare_op::less_equal>) noexcept
+{
+	return x <= lo;
+}
+
+template <typename T>
+bool compare_scalar(const T x, const T lo, const T, compare_op_tag<compare_op::greater>) noexcept
+{
+	return x > lo;
+}
+
+template <typename T>
+bool compare_scalar(const T x, const T lo, const T, compare_op_tag<compare_op::greater_equal>) noexcept
+{
+	return x >= lo;
+}
+
+template <typename T>
+bool compare_scalar(const T x, const T lo, const T hi, compare_op_tag<compare_op::between>) noexcept
+{
+	return (x >= lo) & (x <= hi);
+}
+
+template <compare_op Op, typename T>
+uint64_t compare_block_scalar(const T* column, const std::size_t count, const T lo, const T hi) noexcept
+{
+	uint64_t word = 0;
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const bool match = compare_scalar(column[i], lo, hi, compare_op_tag<Op>{});
+		word |= static_cast<uint64_t>(match) << i;
+	}
+
+	return word;
+}
+
+
+/*===========================================================
+||	Every simd_compare specialization exposes vector, lanes,
+||	load(), set1() and one lane mask per comparison.
+===========================================================*/
+
+template <typename T, std::size_t Size = sizeof(T), bool Signed = std::is_signed<T>::value,
+	bool Floating = std::is_floating_point<T>::value>
+struct simd_compare
+{
+	static constexpr bool available = false;
+};
+
+template <typename Traits>
+uint64_t compare_vector(const typename Traits::vector x, const typename Traits::vector lo,
+	const typename Traits::vector, compare_op_tag<compare_op::equal>) noexcept
+{
+	return Traits::eq(x, lo);
+}
+
+template <typename Traits>
+uint64_t compare_vector(const typename Traits::vector x, const typename Traits::vector lo,
+	const typename Traits::vector, compare_op_tag<compare_op::not_equal>) noexcept
+{
+	return Traits::ne(x, lo);
+}
+
+template <typename Traits>
+uint64_t compare_vector(const typename Traits::vector x, const typename Traits::vector lo,
+	const typename Traits::vector, compare_op_tag<compare_op::less>) noexcept
+{
+	return Traits::lt(x, lo);
+}
+
+template <typename Traits>
+uint64_t compare_vector(const typename Traits::vector x, const typename Traits::vector lo,
+	const typename Traits::vector, compare_op_tag<compare_op::less_equal>) noexcept
+{
+	return Traits::le(x, lo);
+}
+
+template <typename Traits>
+uint64_t compare_vector(const typename Traits::vector x, const typename Traits::vector lo,
+	const typename Traits::vector, compare_op_tag<compare_op::greater>) noexcept
+{
+	return Traits::gt(x, lo);
+}
+
+template <typename Traits>
+uint64_t compare_vector(const typename Traits::vector x, const typename Traits::vector lo,
+	const typename Traits::vector, compare_op_tag<compare_op::greater_equal>) noexcept
+{
+	return Traits::ge(x, lo);
+}
+
+template <typename Traits>
+uint64_t compare_vector(const typename Traits::vector x, const typename Traits::vector lo,
+	const typename Traits::vector hi, compare_op_tag<compare_op::between>) noexcept
+{
+	return Traits::ge(x, lo) & Traits::le(x, hi);
+}
+
+#if defined(BIT14_USING_AVX512)
+#define BIT14_AVX512_COMPARE(SIZE, SIGNED, FLOATING, VECTOR, LOAD, SET1, CMP,			\
+	EQ, NE, LT, LE, GT, GE)																\
+template <typename T>																	\
+struct simd_compare<T, SIZE, SIGNED, FLOATING>											\
+{																						\
+	using vector = VECTOR;																\
+	static constexpr bool available = true;												\
+	static constexpr int lanes = 64 / SIZE;												\
+																						\
+	static vector load(const T* p) noexcept												\
+	{																					\
+		return LOAD(p);																	\
+	}																					\
+																						\
+	static vector set1(const T value) noexcept											\
+	{																					\
+		return SET1(value);																\
+	}																					\
+																						\
+	static uint64_t eq(const vector a, const vector b) noexcept							\
+	{																					\
+		return CMP(a, b, EQ);															\
+	}																					\
+																						\
+	static uint64_t ne(const vector a, const vector b) noexcept							\
+	{																					\
+		return CMP(a, b, NE);															\
+	}																					\
+																						\
+	static uint64_t lt(const vector a, const vector b) noexcept							\
+	{																					\
+		return CMP(a, b, LT);															\
+	}																					\
+																						\
+	static uint64_t le(const vector a, const vector b) noexcept							\
+	{																					\
+		return CMP(a, b, LE);															\
+	}																					\
+																						\
+	static uint64_t gt(const vector a, const vector b) noexcept							\
+	{																					\
+		return CMP(a, b, GT);															\
+	}																					\
+																						\
+	static uint64_t ge(const vector a, const vector b) noexcept							\
+	{																					\
+		return CMP(a, b, GE);															\
+	}																					\
+};
+
+#define BIT14_AVX512_LOAD_SI(p) _mm512_loadu_si512(static_cast<const void*>(p))
+#define BIT14_AVX512_SET1_8(x) _mm512_set1_epi8(static_cast<char>(x))
+#define BIT14_AVX512_SET1_16(x) _mm512_set1_epi16(static_cast<short>(x))
+#define BIT14_AVX512_SET1_32(x) _mm512_set1_epi32(static_cast<int>(x))
+#define BIT14_AVX512_SET1_64(x) _mm512_set1_epi64(static_cast<long long>(x))
+#define BIT14_AVX512_INT_COMPARE(SIZE, SIGNED, SET1, CMP)								\
+	BIT14_AVX512_COMPARE(SIZE, SIGNED, false, __m512i, BIT14_AVX512_LOAD_SI, SET1, CMP,	\
+		_MM_CMPINT_EQ, _MM_CMPINT_NE, _MM_CMPINT_LT, _MM_CMPINT_LE, _MM_CMPINT_NLE, _MM_CMPINT_NLT)
+#define BIT14_AVX512_FLOAT_COMPARE(SIZE, VECTOR, LOAD, SET1, CMP)						\
+	BIT14_AVX512_COMPARE(SIZE, true, true, VECTOR, LOAD, SET1, CMP,						\
+		_CMP_EQ_OQ, _CMP_NEQ_UQ, _CMP_LT_OQ, _CMP_LE_OQ, _CMP_GT_OQ, _CMP_GE_OQ)
+
+BIT14_AVX512_INT_COMPARE(1, true, BIT14_AVX512_SET1_8, _mm512_cmp_epi8_mask)
+BIT14_AVX512_INT_COMPARE(1, false, BIT14_AVX512_SET1_8, _mm512_cmp_epu8_mask)
+BIT14_AVX512_INT_COMPARE(2, true, BIT14_AVX512_SET1_16, _mm512_cmp_epi16_mask)
+BIT14_AVX512_INT_COMPARE(2, false, BIT14_AVX512_SET1_16, _mm512_cmp_epu16_mask)
+BIT14_AVX512_INT_COMPARE(4, true, BIT14_AVX512_SET1_32, _mm512_cmp_epi32_mask)
+BIT14_AVX512_INT_COMPARE(4, false, BIT14_AVX512_SET1_32, _mm512_cmp_epu32_mask)
+BIT14_AVX512_INT_COMPARE(8, true, BIT14_AVX512_SET1_64, _mm512_cmp_epi64_mask)
+BIT14_AVX512_INT_COMPARE(8, false, BIT14_AVX512_SET1_64, _mm512_cmp_epu64_mask)
+BIT14_AVX512_FLOAT_COMPARE(4, __m512, _mm512_loadu_ps, _mm512_set1_ps, _mm512_cmp_ps_mask)
+BIT14_AVX512_FLOAT_COMPARE(8, __m512d, _mm512_loadu_pd, _mm512_set1_pd, _mm512_cmp_pd_mask)
+
+#undef BIT14_AVX512_COMPARE
+#undef BIT14_AVX512_LOAD_SI
+#undef BIT14_AVX512_SET1_8
+#undef BIT14_AVX512_SET1_16
+#undef BIT14_AVX512_SET1_32
+#undef BIT14_AVX512_SET1_64
+#undef BIT14_AVX512_INT_COMPARE
+#undef BIT14_AVX512_FLOAT_COMPARE
+
+#elif defined(BIT14_USING_AVX2)
+//AVX2 only has signed greater than, unsigned lanes get their sign bit flipped on load.
+inline __m256i avx2_flip_sign(const __m256i x, const __m256i, std::true_type) noexcept
+{
+	return x;
+}
+
+inline __m256i avx2_flip_sign(const __m256i x, const __m256i sign, std::false_type) noexcept
+{
+	return _mm256_xor_si256(x, sign);
+}
+
+template <std::size_t Size>
+struct avx2_int_ops;
+
+template <>
+struct avx2_int_ops<1>
+{
+	static constexpr int lanes = 32;
+
+	static __m256i sign() noexcept
+	{
+		return _mm256_set1_epi8(static_cast<char>(0x80));
+	}
+
+	static __m256i set1(const uint64_t value) noexcept
+	{
+		return _mm256_set1_epi8(static_cast<char>(value));
+	}
+
+	static uint64_t eq(const __m256i a, const __m256i b) noexcept
+	{
+		return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+	}
+
+	static uint64_t gt(const __m256i a, const __m256i b) noexcept
+	{
+		return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(a, b)));
+	}
+};
+
+template <>
+struct avx2_int_ops<2>
+{
+	static constexpr int lanes = 16;
+
+	static __m256i sign() noexcept
+	{
+		return _mm256_set1_epi16(static_cast<short>(0x8000));
+	}
+
+	static __m256i set1(const uint64_t value) noexcept
+	{
+		return _mm256_set1_epi16(static_cast<short>(value));
+	}
+
+	//packs keeps one byte per lane, the permute undoes its per 128 bit interleave
+	static uint64_t movemask(const __m256i m) noexcept
+	{
+		const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(m, m), 0xD8);
+		return static_cast<uint32_t>(_mm256_movemask_epi8(packed)) & 0xFFFF;
+	}
+
+	static uint64_t eq(const __m256i a, const __m256i b) noexcept
+	{
+		return movemask(_mm256_cmpeq_epi16(a, b));
+	}
+
+	static uint64_t gt(const __m256i a, const __m256i b) noexcept
+	{
+		return movemask(_mm256_cmpgt_epi16(a, b));
+	}
+};
+
+template <>
+struct avx2_int_ops<4>
+{
+	static constexpr int lanes = 8;
+
+	static __m256i sign() noexcept
+	{
+		return _mm256_set1_epi32(static_cast<int>(0x80000000u));
+	}
+
+	static __m256i set1(const uint64_t value) noexcept
+	{
+		return _mm256_set1_epi32(static_cast<int>(value));
+	}
+
+	static uint64_t eq(const __m256i a, const __m256i b) noexcept
+	{
+		const __m256 m = _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b));
+		return static_cast<uint32_t>(_mm256_movemask_ps(m));
+	}
+
+	static uint64_t gt(const __m256i a, const __m256i b) noexcept
+	{
+		const __m256 m = _mm256_castsi256_ps(_mm256_cmpgt_epi32(a, b));
+		return static_cast<uint32_t>(_mm256_movemask_ps(m));
+	}
+};
+
+template <>
+struct avx2_int_ops<8>
+{
+	static constexpr int lanes = 4;
+
+	static __m256i sign() noexcept
+	{
+		return _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+	}
+
+	static __m256i set1(const uint64_t value) noexcept
+	{
+		return _mm256_set1_epi64x(static_cast<long long>(value));
+	}
+
+	static uint64_t eq(const __m256i a, const __m256i b) noexcept
+	{
+		const __m256d m = _mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b));
+		return static_cast<uint32_t>(_mm256_movemask_pd(m));
+	}
+
+	static uint64_t gt(const __m256i a, const __m256i b) noexcept
+	{
+		const __m256d m = _mm256_castsi256_pd(_mm256_cmpgt_epi64(a, b));
+		return static_cast<uint32_t>(_mm256_movemask_pd(m));
+	}
+};
+
+template <typename T, std::size_t Size, bool Signed>
+struct simd_compare<T, Size, Signed, false>
+{
+	using vector = __m256i;
+	using ops = avx2_int_ops<Size>;
+	using is_signed = std::integral_constant<bool, Signed>;
+	static constexpr bool available = true;
+	static constexpr int lanes = ops::lanes;
+
+	static vector load(const T* p) noexcept
+	{
+		const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		return avx2_flip_sign(x, ops::sign(), is_signed{});
+	}
+
+	static vector set1(const T value) noexcept
+	{
+		return avx2_flip_sign(ops::set1(static_cast<uint64_t>(value)), ops::sign(), is_signed{});
+	}
+
+	static uint64_t eq(const vector a, const vector b) noexcept
+	{
+		return ops::eq(a, b);
+	}
+
+	static uint64_t ne(const vector a, const vector b) noexcept
+	{
+		constexpr uint64_t full = ~uint64_t{ 0 } >> (64 - lanes);
+		return ~ops::eq(a, b) & full;
+	}
+
+	static uint64_t lt(const vector a, const vector b) noexcept
+	{
+		return ops::gt(b, a);
+	}
+
+	static uint64_t le(const vector a, const vector b) noexcept
+	{
+		constexpr uint64_t full = ~uint64_t{ 0 } >> (64 - lanes);
+		return ~ops::gt(a, b) & full;
+	}
+
+	static uint64_t gt(const vector a, const vector b) noexcept
+	{
+		return ops::gt(a, b);
+	}
+
+	static uint64_t ge(const vector a, const vector b) noexcept
+	{
+		constexpr uint64_t full = ~uint64_t{ 0 } >> (64 - lanes);
+		return ~ops::gt(b, a) & full;
+	}
+};
+
+#define BIT14_AVX2_FLOAT_COMPARE(SIZE, VECTOR, LANES, LOAD, SET1, CMP, MOVEMASK)		\
+template <typename T>																	\
+struct simd_compare<T, SIZE, true, true>												\
+{																						\
+	using vector = VECTOR;																\
+	static constexpr bool available = true;												\
+	static constexpr int lanes = LANES;													\
+																						\
+	static vector load(const T* p) noexcept												\
+	{																					\
+		return LOAD(p);																	\
+	}																					\
+																						\
+	static vector set1(const T value) noexcept											\
+	{																					\
+		return SET1(value);																\
+	}																					\
+																						\
+	static uint64_t eq(const vector a, const vector b) noexcept							\
+	{																					\
+		return static_cast<uint32_t>(MOVEMASK(CMP(a, b, _CMP_EQ_OQ)));					\
+	}																					\
+																						\
+	static uint64_t ne(const vector a, const vector b) noexcept							\
+	{																					\
+		return static_cast<uint32_t>(MOVEMASK(CMP(a, b, _CMP_NEQ_UQ)));					\
+	}																					\
+																						\
+	static uint64_t lt(const vector a, const vector b) noexcept							\
+	{																					\
+		return static_cast<uint32_t>(MOVEMASK(CMP(a, b, _CMP_LT_OQ)));					\
+	}																					\
+																						\
+	static uint64_t le(const vector a, const vector b) noexcept							\
+	{																					\
+		return static_cast<uint32_t>(MOVEMASK(CMP(a, b, _CMP_LE_OQ)));					\
+	}																					\
+																						\
+	static uint64_t gt(const vector a, const vector b) noexcept							\
+	{																					\
+		return static_cast<uint32_t>(MOVEMASK(CMP(a, b, _CMP_GT_OQ)));					\
+	}																					\
+																						\
+	static uint64_t ge(const vector a, const vector b) noexcept							\
+	{																					\
+		return static_cast<uint32_t>(MOVEMASK(CMP(a, b, _CMP_GE_OQ)));					\
+	}																					\
+};
+
+BIT14_AVX2_FLOAT_COMPARE(4, __m256, 8, _mm256_loadu_ps, _mm256_set1_ps, _mm256_cmp_ps, _mm256_movemask_ps)
+BIT14_AVX2_FLOAT_COMPARE(8, __m256d, 4, _mm256_loadu_pd, _mm256_set1_pd, _mm256_cmp_pd, _mm256_movemask_pd)
+#undef BIT14_AVX2_FLOAT_COMPARE
+#endif //end of #if defined(BIT14_USING_AVX512)
+
+template <compare_op Op, typename T>
+std::size_t compare_to_mask_impl(const T* column, const std::size_t n, const T lo, const T hi,
+	uint64_t* mask_out, std::false_type) noexcept
+{
+	std::size_t count = 0;
+	std::size_t i = 0;
+
+	for (; i + 64 <= n; i += 64)
+	{
+		const uint64_t word = compare_block_scalar<Op>(column + i, 64, lo, hi);
+		*mask_out++ = word;
+		count += static_cast<std::size_t>(bit14::popcount(word));
+	}
+
+	if (i < n)
+	{
+		const uint64_t word = compare_block_scalar<Op>(column + i, n - i, lo, hi);
+		*mask_out = word;
+		count += static_cast<std::size_t>(bit14::popcount(word));
+	}
+
+	return count;
+}
+
+template <compare_op Op, typename T>
+std::size_t compare_to_mask_impl(const T* column, const std::size_t n, const T lo, const T hi,
+	uint64_t* mask_out, std::true_type) noexcept
+{
+	using traits = simd_compare<T>;
+	const typename traits::vector lo_vector = traits::set1(lo);
+	const typename traits::vector hi_vector = traits::set1(hi);
+	std::size_t count = 0;
+	std::size_t i = 0;
+
+	for (; i + 64 <= n; i += 64)
+	{
+		uint64_t word = 0;
+
+		for (int lane = 0; lane < 64; lane += traits::lanes)
+		{
+			const typename traits::vector x = traits::load(column + i + lane);
+			word |= compare_vector<traits>(x, lo_vector, hi_vector, compare_op_tag<Op>{}) << lane;
+		}
+
+		*mask_out++ = word;
+		count += static_cast<std::size_t>(bit14::popcount(word));
+	}
+
+	if (i < n)
+	{
+		const uint64_t word = compare_block_scalar<Op>(column + i, n - i, lo, hi);
+		*mask_out = word;
+		count += static_cast<std::size_t>(bit14::popcount(word));
+	}
+
+	return count;
+}
+} //end namespace detail
+
+template <compare_op Op, typename T>
+std::size_t compare_to_mask(const T* column, const std::size_t n, const T lo, const T hi,
+	uint64_t* mask_out) noexcept
+{
+	static_assert((std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+		std::is_floating_point<T>::value,
+			"bit14::compare_to_mask requires an integer or floating point column.\n");
+
+	using has_simd = std::integral_constant<bool, detail::simd_compare<T>::available>;
+	return detail::compare_to_mask_impl<Op>(column, n, lo, hi, mask_out, has_simd{});
+}
+
+template <compare_op Op, typename T>
+std::size_t compare_to_mask(const T* column, const std::size_t n, const T value,
+	uint64_t* mask_out) noexcept
+{
+	return bit14::compare_to_mask<Op>(column, n, value, value, mask_out);
+}
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
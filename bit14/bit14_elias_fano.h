@@ -0,0 +1,327 @@
+//bit14_elias_fano.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	bit14::elias_fano stores a non-decreasing sequence of n uint64_t
+|||	values below or equal to m in about 2 + log2(m / n) bits each.
+|||	Every value is split at l = floor(log2(m / n)) bits: the low
+|||	parts are packed at l bits each, the high parts are written in
+|||	unary into a bitvector where element i sets bit (value >> l) + i.
+|||
+|||	Every 256th one and every 256th zero of the high bitvector is
+|||	sampled, so locating the i-th element or the start of a high
+|||	bucket scans a few words from the nearest sample with popcount
+|||	and finishes inside the word with select_in_word(), one pdep with
+|||	BMI2 or a broadword byte search otherwise.
+|||
+|||		elias_fano(const uint64_t* values, std::size_t n);
+|||		uint64_t access(std::size_t i) const noexcept;		//also operator[]
+|||		const_iterator next_geq(uint64_t x) const noexcept;	//first value >= x
+|||		const_iterator begin() const noexcept;
+|||		const_iterator end() const noexcept;
+|||		std::size_t size() const noexcept;
+|||		bool empty() const noexcept;
+|||		std::size_t size_in_bytes() const noexcept;
+|||
+|||	next_geq() jumps to the bucket of x >> l through the zero samples
+|||	and walks its elements with countr_zero, returning end() when all
+|||	values are below x. The iterator decodes sequentially: ++ finds
+|||	the next one bit of the high bitvector in the current or following
+|||	words and reads the next low part. index() tells its position.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <vector>			//vector
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+#ifdef BIT14_USING_BMI2
+#include <immintrin.h>
+#endif
+
+namespace bit14
+{
+namespace detail
+{
+//Position of the set bit of x with rank r (0 based), r must be below popcount(x).
+inline int select_in_word(const uint64_t x, const int r) noexcept
+{
+#ifdef BIT14_USING_BMI2
+	return bit14::countr_zero(_pdep_u64(uint64_t{ 1 } << r, x));
+#else
+	uint64_t sums = x - ((x >> 1) & 0x5555555555555555ull);
+	sums = (sums & 0x3333333333333333ull) + ((sums >> 2) & 0x3333333333333333ull);
+	sums = ((sums + (sums >> 4)) & 0x0F0F0F0F0F0F0F0Full) * 0x0101010101010101ull;
+
+	//Byte j of sums counts the ones of bytes 0 to j, the bytes counting at most r come first.
+	const uint64_t below = ((static_cast<uint64_t>(r) * 0x0101010101010101ull | 0x8080808080808080ull) - sums) &
+		0x8080808080808080ull;
+	const int byte = bit14::popcount(below);
+	const int before = (byte == 0) ? 0 : static_cast<int>((sums >> (8 * byte - 8)) & 0xFF);
+	unsigned int bits = static_cast<unsigned int>(x >> (8 * byte)) & 0xFF;
+
+	for (int skip = r - before; skip > 0; --skip)
+		bits &= bits - 1;
+
+	return 8 * byte + bit14::countr_zero(bits);
+#endif
+}
+} //end namespace detail
+
+class elias_fano
+{
+public:
+	static constexpr std::size_t sample_rate = 256;
+
+	class const_iterator
+	{
+	public:
+		const_iterator() noexcept : m_owner(nullptr), m_index(0), m_position(0), m_value(0) {}
+
+		uint64_t operator*() const noexcept
+		{
+			return m_value;
+		}
+
+		std::size_t index() const noexcept
+		{
+			return m_index;
+		}
+
+		const_iterator& operator++() noexcept
+		{
+			if (++m_index < m_owner->m_size)
+			{
+				m_position = m_owner->next_one(m_position + 1);
+				m_value = m_owner->value_at(m_index, m_position);
+			}
+
+			return *this;
+		}
+
+		bool operator==(const const_iterator& other) const noexcept
+		{
+			return m_index == other.m_index;
+		}
+
+		bool operator!=(const const_iterator& other) const noexcept
+		{
+			return m_index != other.m_index;
+		}
+
+	private:
+		friend class elias_fano;
+
+		const_iterator(const elias_fano* owner, const std::size_t index, const std::size_t position) noexcept
+			: m_owner(owner), m_index(index), m_position(position),
+			m_value(index < owner->m_size ? owner->value_at(index, position) : 0) {}
+
+		const elias_fano* m_owner;
+		std::size_t m_index;
+		std::size_t m_position;
+		uint64_t m_value;
+	};
+
+	elias_fano() noexcept : m_size(0), m_largest(0), m_low_bits(0), m_low_mask(0) {}
+
+	elias_fano(const uint64_t* values, const std::size_t n)
+		: m_size(n), m_largest(n ? values[n - 1] : 0), m_low_bits(0), m_low_mask(0)
+	{
+		const uint64_t largest = m_largest;
+		const uint64_t span = n ? largest / n : 0;
+		m_low_bits = span ? bit14::bit_width(span) - 1 : 0;
+		m_low_mask = m_low_bits ? ~uint64_t{ 0 } >> (64 - m_low_bits) : 0;
+
+		//One spare word lets value_at() read two words without a bounds check.
+		m_low.assign(n * static_cast<std::size_t>(m_low_bits) / 64 + 2, 0);
+		const std::size_t high_bits = n + static_cast<std::size_t>(largest >> m_low_bits) + 1;
+		m_high.assign((high_bits + 63) / 64, 0);
+
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			assert(i == 0 || values[i - 1] <= values[i]);
+			const uint64_t low = values[i] & m_low_mask;
+			const std::size_t bit = i * static_cast<std::size_t>(m_low_bits);
+
+			if (m_low_bits)
+			{
+				m_low[bit / 64] |= low << (bit % 64);
+
+				if (bit % 64 + static_cast<std::size_t>(m_low_bits) > 64)
+					m_low[bit / 64 + 1] |= low >> (64 - bit % 64);
+			}
+
+			const std::size_t high = static_cast<std::size_t>(values[i] >> m_low_bits) + i;
+			m_high[high / 64] |= uint64_t{ 1 } << (high % 64);
+		}
+
+		std::size_t ones = 0;
+		std::size_t zeros = 0;
+
+		for (std::size_t bit = 0; bit < high_bits; ++bit)
+		{
+			if ((m_high[bit / 64] >> (bit % 64)) & 1)
+			{
+				if (ones++ % sample_rate == 0)
+					m_one_samples.push_back(bit);
+			}
+			else if (zeros++ % sample_rate == 0)
+			{
+				m_zero_samples.push_back(bit);
+			}
+		}
+	}
+
+	std::size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	std::size_t size_in_bytes() const noexcept
+	{
+		return (m_low.size() + m_high.size()) * sizeof(uint64_t) +
+			(m_one_samples.size() + m_zero_samples.size()) * sizeof(std::size_t);
+	}
+
+	uint64_t access(const std::size_t i) const noexcept
+	{
+		assert(i < m_size);
+		return value_at(i, select(i, m_one_samples, 0));
+	}
+
+	uint64_t operator[](const std::size_t i) const noexcept
+	{
+		return access(i);
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return const_iterator(this, 0, m_size ? next_one(0) : 0);
+	}
+
+	const_iterator end() const noexcept
+	{
+		return const_iterator(this, m_size, 0);
+	}
+
+	const_iterator next_geq(const uint64_t x) const noexcept
+	{
+		if (m_size == 0)
+			return end();
+
+		const uint64_t bucket = x >> m_low_bits;
+
+		if (bucket > m_largest >> m_low_bits)
+			return end();
+
+		//Bucket b begins after the b-th zero, every bit before it is one of the first position - b elements.
+		std::size_t position = bucket ? select(static_cast<std::size_t>(bucket) - 1, m_zero_samples, ~uint64_t{ 0 }) + 1 : 0;
+		std::size_t index = position - static_cast<std::size_t>(bucket);
+
+		while (index < m_size)
+		{
+			position = next_one(position);
+			const uint64_t value = value_at(index, position);
+
+			if (value >= x)
+				return const_iterator(this, index, position);
+
+			++position;
+			++index;
+		}
+
+		return end();
+	}
+
+private:
+	uint64_t low_at(const std::size_t i) const noexcept
+	{
+		const std::size_t bit = i * static_cast<std::size_t>(m_low_bits);
+		const int shift = static_cast<int>(bit % 64);
+		const uint64_t joined = (m_low[bit / 64] >> shift) | ((m_low[bit / 64 + 1] << 1) << (63 - shift));
+		return joined & m_low_mask;
+	}
+
+	uint64_t value_at(const std::size_t i, const std::size_t position) const noexcept
+	{
+		return (static_cast<uint64_t>(position - i) << m_low_bits) | low_at(i);
+	}
+
+	//First one bit at or after position, which must exist.
+	std::size_t next_one(const std::size_t position) const noexcept
+	{
+		std::size_t word = position / 64;
+		uint64_t bits = m_high[word] & (~uint64_t{ 0 } << (position % 64));
+
+		while (bits == 0)
+			bits = m_high[++word];
+
+		return word * 64 + static_cast<std::size_t>(bit14::countr_zero(bits));
+	}
+
+	//Position of the k-th one (flip 0) or zero (flip all ones) of the high bitvector.
+	std::size_t select(std::size_t k, const std::vector<std::size_t>& samples, const uint64_t flip) const noexcept
+	{
+		const std::size_t start = samples[k / sample_rate];
+		k %= sample_rate;
+
+		std::size_t word = start / 64;
+		uint64_t bits = (m_high[word] ^ flip) & (~uint64_t{ 0 } << (start % 64));
+		std::size_t count = static_cast<std::size_t>(bit14::popcount(bits));
+
+		while (count <= k)
+		{
+			k -= count;
+			bits = m_high[++word] ^ flip;
+			count = static_cast<std::size_t>(bit14::popcount(bits));
+		}
+
+		return word * 64 + static_cast<std::size_t>(detail::select_in_word(bits, static_cast<int>(k)));
+	}
+
+	std::size_t m_size;
+	uint64_t m_largest;
+	int m_low_bits;
+	uint64_t m_low_mask;
+	std::vector<uint64_t> m_low;
+	std::vector<uint64_t> m_high;
+	std::vector<std::size_t> m_one_samples;
+	std::vector<std::size_t> m_zero_samples;
+};
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
@@ -0,0 +1,156 @@
+//bit14_eytzinger_set.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	bit14::eytzinger_set<T> is a static search tree built from a sorted
+|||	array. Keys are stored in breadth first (Eytzinger) order, node k
+|||	has children 2k and 2k + 1, so the top levels of every search share
+|||	the same few cache lines.
+|||
+|||		eytzinger_set(const T* sorted, std::size_t n);
+|||		std::size_t size() const noexcept;
+|||		bool empty() const noexcept;
+|||		std::size_t lower_bound(const T& key) const noexcept;
+|||		std::size_t upper_bound(const T& key) const noexcept;
+|||		bool contains(const T& key) const noexcept;
+|||		std::size_t lower_bound_slot(const T& key) const noexcept;
+|||		const T& slot_key(std::size_t slot) const noexcept;
+|||
+|||	The descent is branchless, k = 2k + (key_k < key), and prefetches
+|||	the cache line holding the descendants several levels down. Every
+|||	right turn appends a 1 bit to k and the answer is the node of the
+|||	last left turn, so it is recovered with k >> (countr_one(k) + 1).
+|||
+|||	lower_bound() and upper_bound() return positions in the sorted input,
+|||	size() when no key qualifies. lower_bound_slot() returns the tree
+|||	slot instead, 0 when no key qualifies, for callers that keep their
+|||	own data in Eytzinger order. T must be default constructible and
+|||	ordered by operator<.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <cstdint>			//uintptr_t
+#include <vector>			//vector
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+template <typename T>
+class eytzinger_set
+{
+public:
+	eytzinger_set(const T* const sorted, const std::size_t n) : m_keys(n + 1), m_positions(n + 1)
+	{
+		m_positions[0] = n;
+		std::size_t next = 0;
+		build(sorted, next, 1);
+	}
+
+	std::size_t size() const noexcept
+	{
+		return m_keys.size() - 1;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_keys.size() == 1;
+	}
+
+	std::size_t lower_bound_slot(const T& key) const noexcept
+	{
+		return descend(key, [](const T& node, const T& target) { return node < target; });
+	}
+
+	const T& slot_key(const std::size_t slot) const noexcept
+	{
+		return m_keys[slot];
+	}
+
+	std::size_t lower_bound(const T& key) const noexcept
+	{
+		return m_positions[lower_bound_slot(key)];
+	}
+
+	std::size_t upper_bound(const T& key) const noexcept
+	{
+		return m_positions[descend(key, [](const T& node, const T& target) { return !(target < node); })];
+	}
+
+	bool contains(const T& key) const noexcept
+	{
+		const std::size_t slot = lower_bound_slot(key);
+		return slot != 0 && !(key < m_keys[slot]);
+	}
+
+private:
+	//Nodes 16k to 16k + 15 share a cache line for 4 byte keys, prefetching
+	//there covers the next four levels of the descent.
+	static constexpr std::size_t prefetch_stride = (64 / sizeof(T) > 0) ? 64 / sizeof(T) : 1;
+
+	template <typename GoRight>
+	std::size_t descend(const T& key, GoRight go_right) const noexcept
+	{
+		const std::size_t n = size();
+		const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_keys.data());
+		std::size_t k = 1;
+
+		while (k <= n)
+		{
+			detail::prefetch(reinterpret_cast<const void*>(base + k * prefetch_stride * sizeof(T)));
+			k = 2 * k + static_cast<std::size_t>(go_right(m_keys[k], key));
+		}
+
+		return k >> (bit14::countr_one(k) + 1);
+	}
+
+	//In order traversal of the implicit tree hands out the sorted keys.
+	void build(const T* const sorted, std::size_t& next, const std::size_t k)
+	{
+		if (k >= m_keys.size())
+			return;
+
+		build(sorted, next, 2 * k);
+		m_keys[k] = sorted[next];
+		m_positions[k] = next++;
+		build(sorted, next, 2 * k + 1);
+	}
+
+	std::vector<T> m_keys;
+	std::vector<std::size_t> m_positions;
+};
+
+template <typename T>
+constexpr std::size_t eytzinger_set<T>::prefetch_stride;
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
@@ -0,0 +1,266 @@
+//bit14_fenwick_tree.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	bit14::fenwick_tree<T> is a binary indexed tree over n values of an
+|||	arithmetic type. Updates climb with k += 1 << countr_zero(k), prefix
+|||	sums descend by clearing the lowest set bit, and lower_bound walks
+|||	down from bit14::bit_floor(n) one bit at a time.
+|||
+|||		explicit fenwick_tree(std::size_t n);
+|||		fenwick_tree(const T* values, std::size_t n);	//O(n) construction
+|||		std::size_t size() const noexcept;
+|||		void add(std::size_t i, T delta) noexcept;
+|||		T prefix_sum(std::size_t i) const noexcept;		//sum of [0, i)
+|||		T range_sum(std::size_t first, std::size_t last) const noexcept;	//sum of [first, last)
+|||		T total() const noexcept;
+|||		std::size_t lower_bound(T target) const noexcept;
+|||
+|||	lower_bound() returns the smallest i with prefix_sum(i + 1) >= target,
+|||	or size() when the total is below target. It requires every value
+|||	to be non negative.
+|||
+|||	bit14::blocked_fenwick_tree<T, BlockBits> offers the same interface
+|||	for large n. It keeps one small tree per block of 2^BlockBits values,
+|||	stored contiguously, plus a tree over the block totals, so an update
+|||	or query touches one block instead of cache lines spread over the
+|||	whole array.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <vector>			//vector
+#include <type_traits>		//is_arithmetic
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+namespace detail
+{
+//The tree uses 1 based node numbers k, node k is stored in tree[k - 1].
+template <typename T>
+void fenwick_build(T* const tree, const std::size_t n) noexcept
+{
+	for (std::size_t k = 1; k <= n; ++k)
+	{
+		const std::size_t parent = k + (std::size_t{ 1 } << bit14::countr_zero(k));
+
+		if (parent <= n)
+			tree[parent - 1] += tree[k - 1];
+	}
+}
+
+template <typename T>
+void fenwick_add(T* const tree, const std::size_t n, const std::size_t i, const T delta) noexcept
+{
+	for (std::size_t k = i + 1; k <= n; k += std::size_t{ 1 } << bit14::countr_zero(k))
+		tree[k - 1] += delta;
+}
+
+template <typename T>
+T fenwick_prefix_sum(const T* const tree, std::size_t k) noexcept
+{
+	T result = T();
+
+	for (; k != 0; k &= k - 1)
+		result += tree[k - 1];
+
+	return result;
+}
+
+//Leaves the part of target that is left after the returned position in target.
+template <typename T>
+std::size_t fenwick_lower_bound(const T* const tree, const std::size_t n, T& target) noexcept
+{
+	std::size_t position = 0;
+
+	for (std::size_t step = bit14::bit_floor(n); step != 0; step >>= 1)
+	{
+		const std::size_t next = position + step;
+
+		if (next <= n && tree[next - 1] < target)
+		{
+			position = next;
+			target -= tree[next - 1];
+		}
+	}
+
+	return position;
+}
+} //end namespace detail
+
+template <typename T>
+class fenwick_tree
+{
+	static_assert(std::is_arithmetic<T>::value, "bit14::fenwick_tree requires an arithmetic type.\n");
+
+public:
+	explicit fenwick_tree(const std::size_t n) : m_tree(n, T()) {}
+
+	fenwick_tree(const T* const values, const std::size_t n) : m_tree(values, values + n)
+	{
+		detail::fenwick_build(m_tree.data(), n);
+	}
+
+	std::size_t size() const noexcept
+	{
+		return m_tree.size();
+	}
+
+	void add(const std::size_t i, const T delta) noexcept
+	{
+		detail::fenwick_add(m_tree.data(), m_tree.size(), i, delta);
+	}
+
+	T prefix_sum(const std::size_t i) const noexcept
+	{
+		return detail::fenwick_prefix_sum(m_tree.data(), i);
+	}
+
+	T range_sum(const std::size_t first, const std::size_t last) const noexcept
+	{
+		return prefix_sum(last) - prefix_sum(first);
+	}
+
+	T total() const noexcept
+	{
+		return prefix_sum(m_tree.size());
+	}
+
+	std::size_t lower_bound(T target) const noexcept
+	{
+		return detail::fenwick_lower_bound(m_tree.data(), m_tree.size(), target);
+	}
+
+private:
+	std::vector<T> m_tree;
+};
+
+template <typename T, int BlockBits = 9>
+class blocked_fenwick_tree
+{
+	static_assert(std::is_arithmetic<T>::value, "bit14::blocked_fenwick_tree requires an arithmetic type.\n");
+	static_assert(BlockBits > 0 && BlockBits < 32, "bit14::blocked_fenwick_tree block size is out of range.\n");
+
+public:
+	explicit blocked_fenwick_tree(const std::size_t n) : m_blocks(n, T()), m_top(block_count(n)) {}
+
+	blocked_fenwick_tree(const T* const values, const std::size_t n)
+		: m_blocks(values, values + n), m_top(block_count(n))
+	{
+		std::vector<T> totals(block_count(n), T());
+
+		for (std::size_t i = 0; i < n; ++i)
+			totals[i >> BlockBits] += values[i];
+
+		for (std::size_t b = 0; b < totals.size(); ++b)
+			detail::fenwick_build(block(b), block_size(b));
+
+		m_top = fenwick_tree<T>(totals.data(), totals.size());
+	}
+
+	std::size_t size() const noexcept
+	{
+		return m_blocks.size();
+	}
+
+	void add(const std::size_t i, const T delta) noexcept
+	{
+		const std::size_t b = i >> BlockBits;
+		detail::fenwick_add(block(b), block_size(b), i & block_mask, delta);
+		m_top.add(b, delta);
+	}
+
+	T prefix_sum(const std::size_t i) const noexcept
+	{
+		const std::size_t b = i >> BlockBits;
+
+		if (b == m_top.size())
+			return m_top.total();
+
+		return m_top.prefix_sum(b) + detail::fenwick_prefix_sum(block(b), i & block_mask);
+	}
+
+	T range_sum(const std::size_t first, const std::size_t last) const noexcept
+	{
+		return prefix_sum(last) - prefix_sum(first);
+	}
+
+	T total() const noexcept
+	{
+		return m_top.total();
+	}
+
+	std::size_t lower_bound(T target) const noexcept
+	{
+		const std::size_t b = m_top.lower_bound(target);
+
+		if (b == m_top.size())
+			return size();
+
+		target -= m_top.prefix_sum(b);
+		return (b << BlockBits) + detail::fenwick_lower_bound(block(b), block_size(b), target);
+	}
+
+private:
+	static constexpr std::size_t block_mask = (std::size_t{ 1 } << BlockBits) - 1;
+
+	static std::size_t block_count(const std::size_t n) noexcept
+	{
+		return (n + block_mask) >> BlockBits;
+	}
+
+	std::size_t block_size(const std::size_t b) const noexcept
+	{
+		const std::size_t first = b << BlockBits;
+		return (m_blocks.size() - first < block_mask + 1) ? m_blocks.size() - first : block_mask + 1;
+	}
+
+	T* block(const std::size_t b) noexcept
+	{
+		return m_blocks.data() + (b << BlockBits);
+	}
+
+	const T* block(const std::size_t b) const noexcept
+	{
+		return m_blocks.data() + (b << BlockBits);
+	}
+
+	std::vector<T> m_blocks;
+	fenwick_tree<T> m_top;
+};
+
+template <typename T, int BlockBits>
+constexpr std::size_t blocked_fenwick_tree<T, BlockBits>::block_mask;
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
@@ -0,0 +1,355 @@
+//bit14_group_match.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	Control byte group matching for SwissTable style open addressing
+|||	hash tables. Every slot owns one control byte: a full slot stores
+|||	the 7 bit tag of its hash (0 to 127), other slots store one of the
+|||	sentinels ctrl_empty, ctrl_deleted or ctrl_sentinel.
+|||
+|||	A group loads a run of control bytes and returns a match_bitmask
+|||	with one entry per matching slot:
+|||
+|||		explicit group(const ctrl_t* pos) noexcept;
+|||		match_bitmask match(ctrl_t tag) const noexcept;
+|||		match_bitmask match_empty() const noexcept;
+|||		match_bitmask match_deleted() const noexcept;
+|||		match_bitmask match_empty_or_deleted() const noexcept;
+|||
+|||	match_bitmask walks the matches in slot order with bit14::countr_zero
+|||	and offers any(), count(), lowest() and highest(), the latter going
+|||	through bit14::countl_zero.
+|||
+|||	Backends:
+|||		bit14::group_sse2		16 slots, SSE2 compare + movemask
+|||		bit14::group_avx2		32 slots, AVX2 compare + movemask
+|||		bit14::group_neon		8 slots, NEON compare, 8 bits per slot
+|||		bit14::group_portable	8 slots, SWAR over one 64 bit word
+|||
+|||	bit14::group_match names the 16 slot SSE2 group when available,
+|||	otherwise the 8 slot NEON or portable group. Loads are unaligned
+|||	and always read group::width bytes.
+=========================================================================
+=========================================================================*/
+
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+#if defined(BIT14_USING_SSE2) || defined(BIT14_USING_AVX2)
+#include <immintrin.h>
+#endif
+
+#ifdef BIT14_USING_NEON
+#include <arm_neon.h>
+#endif
+
+namespace bit14
+{
+using ctrl_t = signed char;
+
+constexpr ctrl_t ctrl_empty = -128;
+constexpr ctrl_t ctrl_deleted = -2;
+constexpr ctrl_t ctrl_sentinel = -1;
+
+template <typename T, int Width, int Shift = 0>
+class match_bitmask
+{
+	static_assert(detail::is_bit14_type<T>::value,
+		"bit14::match_bitmask requires an unsigned integer mask type.\n");
+	static_assert((Width << Shift) == numeric_limits<T>::digits,
+		"bit14::match_bitmask mask type must have exactly one bit or byte per slot.\n");
+
+public:
+	class iterator
+	{
+	public:
+		explicit iterator(const T mask) noexcept : m_mask(mask) {}
+
+		int operator*() const noexcept
+		{
+			return bit14::countr_zero(m_mask) >> Shift;
+		}
+
+		iterator& operator++() noexcept
+		{
+			m_mask = static_cast<T>(m_mask & (m_mask - 1));
+			return *this;
+		}
+
+		bool operator==(const iterator& other) const noexcept
+		{
+			return m_mask == other.m_mask;
+		}
+
+		bool operator!=(const iterator& other) const noexcept
+		{
+			return m_mask != other.m_mask;
+		}
+
+	private:
+		T m_mask;
+	};
+
+	static constexpr int width = Width;
+
+	explicit match_bitmask(const T mask) noexcept : m_mask(mask) {}
+
+	bool any() const noexcept
+	{
+		return m_mask != 0;
+	}
+
+	explicit operator bool() const noexcept
+	{
+		return m_mask != 0;
+	}
+
+	int count() const noexcept
+	{
+		return bit14::popcount(m_mask);
+	}
+
+	//lowest() and highest() require any() to be true.
+	int lowest() const noexcept
+	{
+		return bit14::countr_zero(m_mask) >> Shift;
+	}
+
+	int highest() const noexcept
+	{
+		constexpr int digits = numeric_limits<T>::digits - 1;
+		return (digits - bit14::countl_zero(m_mask)) >> Shift;
+	}
+
+	//Number of slots before the first match, width when there is none.
+	int leading_slots() const noexcept
+	{
+		return bit14::countr_zero(m_mask) >> Shift;
+	}
+
+	//Number of slots after the last match, width when there is none.
+	int trailing_slots() const noexcept
+	{
+		return bit14::countl_zero(m_mask) >> Shift;
+	}
+
+	T mask() const noexcept
+	{
+		return m_mask;
+	}
+
+	iterator begin() const noexcept
+	{
+		return iterator(m_mask);
+	}
+
+	iterator end() const noexcept
+	{
+		return iterator(0);
+	}
+
+private:
+	T m_mask;
+};
+
+namespace detail
+{
+constexpr uint64_t group_lsbs = 0x0101010101010101ull;
+constexpr uint64_t group_msbs = 0x8080808080808080ull;
+} //end namespace detail
+
+class group_portable
+{
+public:
+	using bitmask = match_bitmask<uint64_t, 8, 3>;
+	static constexpr int width = 8;
+
+	explicit group_portable(const ctrl_t* pos) noexcept : m_ctrl(detail::load_le<uint64_t>(pos)) {}
+
+	bitmask match(const ctrl_t tag) const noexcept
+	{
+		const uint64_t pattern = detail::group_lsbs * static_cast<unsigned char>(tag);
+		return bitmask(detail::has_zero_byte(m_ctrl ^ pattern));
+	}
+
+	//Empty is the only control byte with the high bit set and bit 1 clear.
+	bitmask match_empty() const noexcept
+	{
+		return bitmask(m_ctrl & ~(m_ctrl << 6) & detail::group_msbs);
+	}
+
+	bitmask match_deleted() const noexcept
+	{
+		return match(ctrl_deleted);
+	}
+
+	//Empty and deleted are the only control bytes with the high bit set and bit 0 clear.
+	bitmask match_empty_or_deleted() const noexcept
+	{
+		return bitmask(m_ctrl & ~(m_ctrl << 7) & detail::group_msbs);
+	}
+
+private:
+	uint64_t m_ctrl;
+};
+
+#ifdef BIT14_USING_SSE2
+class group_sse2
+{
+public:
+	using bitmask = match_bitmask<unsigned short, 16>;
+	static constexpr int width = 16;
+
+	explicit group_sse2(const ctrl_t* pos) noexcept
+		: m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+	bitmask match(const ctrl_t tag) const noexcept
+	{
+		return movemask(_mm_cmpeq_epi8(m_ctrl, _mm_set1_epi8(tag)));
+	}
+
+	bitmask match_empty() const noexcept
+	{
+		return match(ctrl_empty);
+	}
+
+	bitmask match_deleted() const noexcept
+	{
+		return match(ctrl_deleted);
+	}
+
+	bitmask match_empty_or_deleted() const noexcept
+	{
+		return movemask(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), m_ctrl));
+	}
+
+private:
+	static bitmask movemask(const __m128i m) noexcept
+	{
+		return bitmask(static_cast<unsigned short>(_mm_movemask_epi8(m)));
+	}
+
+	__m128i m_ctrl;
+};
+#endif //end of #ifdef BIT14_USING_SSE2
+
+#ifdef BIT14_USING_AVX2
+class group_avx2
+{
+public:
+	using bitmask = match_bitmask<uint32_t, 32>;
+	static constexpr int width = 32;
+
+	explicit group_avx2(const ctrl_t* pos) noexcept
+		: m_ctrl(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos))) {}
+
+	bitmask match(const ctrl_t tag) const noexcept
+	{
+		return movemask(_mm256_cmpeq_epi8(m_ctrl, _mm256_set1_epi8(tag)));
+	}
+
+	bitmask match_empty() const noexcept
+	{
+		return match(ctrl_empty);
+	}
+
+	bitmask match_deleted() const noexcept
+	{
+		return match(ctrl_deleted);
+	}
+
+	bitmask match_empty_or_deleted() const noexcept
+	{
+		return movemask(_mm256_cmpgt_epi8(_mm256_set1_epi8(ctrl_sentinel), m_ctrl));
+	}
+
+private:
+	static bitmask movemask(const __m256i m) noexcept
+	{
+		return bitmask(static_cast<uint32_t>(_mm256_movemask_epi8(m)));
+	}
+
+	__m256i m_ctrl;
+};
+#endif //end of #ifdef BIT14_USING_AVX2
+
+#ifdef BIT14_USING_NEON
+class group_neon
+{
+public:
+	using bitmask = match_bitmask<uint64_t, 8, 3>;
+	static constexpr int width = 8;
+
+	explicit group_neon(const ctrl_t* pos) noexcept
+		: m_ctrl(vld1_s8(reinterpret_cast<const int8_t*>(pos))) {}
+
+	bitmask match(const ctrl_t tag) const noexcept
+	{
+		return movemask(vceq_s8(m_ctrl, vdup_n_s8(tag)));
+	}
+
+	bitmask match_empty() const noexcept
+	{
+		return match(ctrl_empty);
+	}
+
+	bitmask match_deleted() const noexcept
+	{
+		return match(ctrl_deleted);
+	}
+
+	bitmask match_empty_or_deleted() const noexcept
+	{
+		return movemask(vclt_s8(m_ctrl, vdup_n_s8(ctrl_sentinel)));
+	}
+
+private:
+	//NEON has no movemask, each slot keeps the high bit of its compare byte instead.
+	static bitmask movemask(const uint8x8_t m) noexcept
+	{
+		const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(m), 0);
+		return bitmask(mask & detail::group_msbs);
+	}
+
+	int8x8_t m_ctrl;
+};
+#endif //end of #ifdef BIT14_USING_NEON
+
+#if defined(BIT14_USING_SSE2)
+using group_match = group_sse2;
+#elif defined(BIT14_USING_NEON)
+using group_match = group_neon;
+#else
+using group_match = group_portable;
+#endif
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
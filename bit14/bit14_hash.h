@@ -0,0 +1,520 @@
+//bit14_hash.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	Fast non-cryptographic hashing of byte strings in the wyhash / xxh3
+|||	family. Output is the same on every platform and byte order: all
+|||	reads go through detail::load_le. It is not bit compatible with
+|||	either reference hash.
+|||
+|||		uint64_t hash64(const void* data, std::size_t size, uint64_t seed = 0) noexcept;
+|||		hash128_value hash128(const void* data, std::size_t size, uint64_t seed = 0) noexcept;
+|||
+|||		class hasher
+|||		{
+|||			explicit hasher(uint64_t seed = 0) noexcept;
+|||			void reset(uint64_t seed = 0) noexcept;
+|||			void update(const void* data, std::size_t size) noexcept;
+|||			uint64_t final64() const noexcept;
+|||			hash128_value final128() const noexcept;
+|||		};
+|||
+|||	A hasher fed the same bytes in any number of pieces returns what
+|||	hash64() / hash128() return for the whole input.
+|||
+|||	Inputs up to 256 bytes follow wyhash. 16 or 48 bytes at a time are
+|||	folded by mum: the 64 x 64 -> 128 bit product of two words, whose
+|||	halves are xored. The last 16 bytes are read as two words that may
+|||	overlap earlier bytes, and a final mum mixes in the length.
+|||
+|||	Longer inputs follow xxh3 and run in eight 64 bit lanes over 64 byte
+|||	stripes. Each lane adds the product of the two 32 bit halves of
+|||	data ^ secret and the neighbouring lane's data word. Every 16
+|||	stripes the lanes are scrambled (xorshift, xor secret, multiply).
+|||	The last 64 bytes are always folded in as one more stripe, then
+|||	pairs of lanes are combined with mum. The AVX2 and SSE2 builds
+|||	handle a stripe with mul_epu32 and give the same results as plain
+|||	builds. The 24 word secret is a fixed table offset by the seed.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <cstring>			//memcpy
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+#if defined(BIT14_USING_SSE2) || defined(BIT14_USING_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace bit14
+{
+struct hash128_value
+{
+	uint64_t low;
+	uint64_t high;
+};
+
+inline bool operator==(const hash128_value& a, const hash128_value& b) noexcept
+{
+	return a.low == b.low && a.high == b.high;
+}
+
+inline bool operator!=(const hash128_value& a, const hash128_value& b) noexcept
+{
+	return !(a == b);
+}
+
+namespace detail
+{
+constexpr std::size_t hash_short_limit = 256;
+constexpr std::size_t hash_stripe = 64;
+constexpr std::size_t hash_block_stripes = 16;
+constexpr std::size_t hash_secret_words = 24;
+constexpr std::size_t hash_last_stripe_word = 9;
+
+constexpr uint64_t hash_prime32_1 = 0x9E3779B1ull;
+constexpr uint64_t hash_prime64_1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t hash_prime64_2 = 0xC2B2AE3D27D4EB4Full;
+
+//wyhash constants for the short path.
+constexpr uint64_t hash_wyp0 = 0xA0761D6478BD642Full;
+constexpr uint64_t hash_wyp1 = 0xE7037ED1A0B428DBull;
+constexpr uint64_t hash_wyp2 = 0x8EBC6AF09C88C6E3ull;
+constexpr uint64_t hash_wyp3 = 0x589965CC75CF109Bull;
+
+#if defined(__SIZEOF_INT128__) && (defined(BIT14_USING_GCC) || defined(BIT14_USING_CLANG))
+__extension__ typedef unsigned __int128 hash_uint128;
+#endif
+
+//Full product of a and b, low half in a and high half in b.
+inline void hash_multiply(uint64_t& a, uint64_t& b) noexcept
+{
+#if defined(__SIZEOF_INT128__) && (defined(BIT14_USING_GCC) || defined(BIT14_USING_CLANG))
+	const hash_uint128 product = static_cast<hash_uint128>(a) * b;
+	a = static_cast<uint64_t>(product);
+	b = static_cast<uint64_t>(product >> 64);
+#elif defined(BIT14_USING_MSVC) && defined(_M_X64)
+	a = _umul128(a, b, &b);
+#else
+	const uint64_t lo_lo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+	const uint64_t hi_lo = (a >> 32) * (b & 0xFFFFFFFF);
+	const uint64_t lo_hi = (a & 0xFFFFFFFF) * (b >> 32);
+	const uint64_t hi_hi = (a >> 32) * (b >> 32);
+	const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+	a = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+	b = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+#endif
+}
+
+inline uint64_t hash_mum(uint64_t a, uint64_t b) noexcept
+{
+	hash_multiply(a, b);
+	return a ^ b;
+}
+
+inline uint64_t hash_avalanche(uint64_t h) noexcept
+{
+	h ^= h >> 37;
+	h *= 0x165667919E3779F9ull;
+	return h ^ (h >> 32);
+}
+
+struct hash_default_secret
+{
+	uint64_t words[hash_secret_words];
+
+	constexpr hash_default_secret() : words()
+	{
+		for (std::size_t i = 0; i < hash_secret_words; ++i)
+		{
+			uint64_t z = hash_prime64_1 * (i + 1);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			words[i] = z ^ (z >> 31);
+		}
+	}
+};
+
+inline void hash_seed_secret(const uint64_t seed, uint64_t* const secret) noexcept
+{
+	static constexpr hash_default_secret defaults{};
+
+	for (std::size_t i = 0; i < hash_secret_words; ++i)
+		secret[i] = defaults.words[i] + ((i & 1) ? 0 - seed : seed);
+}
+
+inline void hash_init_lanes(uint64_t* const lanes) noexcept
+{
+	lanes[0] = 0xC2B2AE3Dull;
+	lanes[1] = hash_prime64_1;
+	lanes[2] = hash_prime64_2;
+	lanes[3] = 0x165667B19E3779F9ull;
+	lanes[4] = 0x85EBCA77C2B2AE63ull;
+	lanes[5] = 0x85EBCA77ull;
+	lanes[6] = 0x27D4EB2F165667C5ull;
+	lanes[7] = hash_prime32_1;
+}
+
+//Stripe n is keyed with secret words n to n + 7.
+inline void hash_accumulate(uint64_t* const lanes, const unsigned char* const data, const std::size_t stripes,
+	const uint64_t* const secret) noexcept
+{
+#if defined(BIT14_USING_AVX2)
+	__m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes));
+	__m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes + 4));
+
+	for (std::size_t n = 0; n < stripes; ++n)
+	{
+		const __m256i* const words = reinterpret_cast<const __m256i*>(data + n * hash_stripe);
+		const __m256i* const keys = reinterpret_cast<const __m256i*>(secret + n);
+		const __m256i data_low = _mm256_loadu_si256(words);
+		const __m256i data_high = _mm256_loadu_si256(words + 1);
+		const __m256i key_low = _mm256_xor_si256(data_low, _mm256_loadu_si256(keys));
+		const __m256i key_high = _mm256_xor_si256(data_high, _mm256_loadu_si256(keys + 1));
+		low = _mm256_add_epi64(low, _mm256_add_epi64(_mm256_mul_epu32(key_low, _mm256_srli_epi64(key_low, 32)),
+			_mm256_shuffle_epi32(data_low, 0x4E)));
+		high = _mm256_add_epi64(high, _mm256_add_epi64(_mm256_mul_epu32(key_high, _mm256_srli_epi64(key_high, 32)),
+			_mm256_shuffle_epi32(data_high, 0x4E)));
+	}
+
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), low);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes + 4), high);
+#elif defined(BIT14_USING_SSE2)
+	__m128i sums[4];
+
+	for (int v = 0; v < 4; ++v)
+		sums[v] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes + 2 * v));
+
+	for (std::size_t n = 0; n < stripes; ++n)
+	{
+		for (int v = 0; v < 4; ++v)
+		{
+			const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + n * hash_stripe + 16 * v));
+			const __m128i keys = _mm_xor_si128(words, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret + n + 2 * v)));
+			sums[v] = _mm_add_epi64(sums[v], _mm_add_epi64(_mm_mul_epu32(keys, _mm_srli_epi64(keys, 32)),
+				_mm_shuffle_epi32(words, 0x4E)));
+		}
+	}
+
+	for (int v = 0; v < 4; ++v)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes + 2 * v), sums[v]);
+#else
+	for (std::size_t n = 0; n < stripes; ++n)
+	{
+		for (std::size_t i = 0; i < 8; ++i)
+		{
+			const uint64_t word = detail::load_le<uint64_t>(data + n * hash_stripe + 8 * i);
+			const uint64_t key = word ^ secret[n + i];
+			lanes[i ^ 1] += word;
+			lanes[i] += (key & 0xFFFFFFFF) * (key >> 32);
+		}
+	}
+#endif
+}
+
+inline void hash_scramble(uint64_t* const lanes, const uint64_t* const secret) noexcept
+{
+#if defined(BIT14_USING_AVX2)
+	const __m256i prime = _mm256_set1_epi64x(static_cast<long long>(hash_prime32_1));
+
+	for (int v = 0; v < 2; ++v)
+	{
+		__m256i* const target = reinterpret_cast<__m256i*>(lanes + 4 * v);
+		__m256i value = _mm256_loadu_si256(target);
+		value = _mm256_xor_si256(value, _mm256_srli_epi64(value, 47));
+		value = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret + 4 * v)));
+		value = _mm256_add_epi64(_mm256_mul_epu32(value, prime),
+			_mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(value, 32), prime), 32));
+		_mm256_storeu_si256(target, value);
+	}
+#elif defined(BIT14_USING_SSE2)
+	const __m128i prime = _mm_set1_epi32(static_cast<int>(hash_prime32_1));
+
+	for (int v = 0; v < 4; ++v)
+	{
+		__m128i* const target = reinterpret_cast<__m128i*>(lanes + 2 * v);
+		__m128i value = _mm_loadu_si128(target);
+		value = _mm_xor_si128(value, _mm_srli_epi64(value, 47));
+		value = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret + 2 * v)));
+		value = _mm_add_epi64(_mm_mul_epu32(value, prime),
+			_mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(value, 32), prime), 32));
+		_mm_storeu_si128(target, value);
+	}
+#else
+	for (std::size_t i = 0; i < 8; ++i)
+	{
+		uint64_t value = lanes[i];
+		value ^= value >> 47;
+		value ^= secret[i];
+		lanes[i] = value * hash_prime32_1;
+	}
+#endif
+}
+
+//Folds whole stripes, scrambling after every block of hash_block_stripes.
+inline void hash_consume(uint64_t* const lanes, const unsigned char* data, std::size_t stripes,
+	uint64_t& count, const uint64_t* const secret) noexcept
+{
+	while (stripes > 0)
+	{
+		const std::size_t in_block = static_cast<std::size_t>(count % hash_block_stripes);
+		const std::size_t run = (stripes < hash_block_stripes - in_block) ? stripes : hash_block_stripes - in_block;
+		hash_accumulate(lanes, data, run, secret + in_block);
+		data += run * hash_stripe;
+		stripes -= run;
+		count += run;
+
+		if (count % hash_block_stripes == 0)
+			hash_scramble(lanes, secret + hash_secret_words - 8);
+	}
+}
+
+inline uint64_t hash_merge(const uint64_t* const lanes, const uint64_t* const secret, uint64_t result) noexcept
+{
+	for (std::size_t i = 0; i < 4; ++i)
+		result += hash_mum(lanes[2 * i] ^ secret[2 * i], lanes[2 * i + 1] ^ secret[2 * i + 1]);
+
+	return hash_avalanche(result);
+}
+
+inline hash128_value hash_long_digest(uint64_t* const lanes, const unsigned char* const last_stripe,
+	const uint64_t size, const uint64_t* const secret) noexcept
+{
+	hash_accumulate(lanes, last_stripe, 1, secret + hash_last_stripe_word);
+	return hash128_value{ hash_merge(lanes, secret + 3, size * hash_prime64_1),
+		hash_merge(lanes, secret + 11, ~(size * hash_prime64_2)) };
+}
+
+inline hash128_value hash_long(const unsigned char* const data, const std::size_t size, const uint64_t seed) noexcept
+{
+	uint64_t secret[hash_secret_words];
+	uint64_t lanes[8];
+	uint64_t count = 0;
+	hash_seed_secret(seed, secret);
+	hash_init_lanes(lanes);
+	hash_consume(lanes, data, (size - 1) / hash_stripe, count, secret);
+	return hash_long_digest(lanes, data + size - hash_stripe, size, secret);
+}
+
+//wyhash body for size <= hash_short_limit, the state ends up in a and b.
+inline void hash_short(const unsigned char* p, const std::size_t size, uint64_t seed, uint64_t& a, uint64_t& b) noexcept
+{
+	seed ^= hash_mum(seed ^ hash_wyp0, hash_wyp1);
+
+	if (size <= 16)
+	{
+		if (size >= 4)
+		{
+			const std::size_t step = (size >> 3) << 2;
+			a = (static_cast<uint64_t>(detail::load_le<uint32_t>(p)) << 32) | detail::load_le<uint32_t>(p + step);
+			b = (static_cast<uint64_t>(detail::load_le<uint32_t>(p + size - 4)) << 32) |
+				detail::load_le<uint32_t>(p + size - 4 - step);
+		}
+		else if (size > 0)
+		{
+			a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[size >> 1]) << 8) | p[size - 1];
+			b = 0;
+		}
+		else
+		{
+			a = 0;
+			b = 0;
+		}
+	}
+	else
+	{
+		std::size_t i = size;
+
+		if (i > 48)
+		{
+			uint64_t see1 = seed;
+			uint64_t see2 = seed;
+
+			do
+			{
+				seed = hash_mum(detail::load_le<uint64_t>(p) ^ hash_wyp1, detail::load_le<uint64_t>(p + 8) ^ seed);
+				see1 = hash_mum(detail::load_le<uint64_t>(p + 16) ^ hash_wyp2, detail::load_le<uint64_t>(p + 24) ^ see1);
+				see2 = hash_mum(detail::load_le<uint64_t>(p + 32) ^ hash_wyp3, detail::load_le<uint64_t>(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while (i > 48);
+
+			seed ^= see1 ^ see2;
+		}
+
+		while (i > 16)
+		{
+			seed = hash_mum(detail::load_le<uint64_t>(p) ^ hash_wyp1, detail::load_le<uint64_t>(p + 8) ^ seed);
+			p += 16;
+			i -= 16;
+		}
+
+		a = detail::load_le<uint64_t>(p + i - 16);
+		b = detail::load_le<uint64_t>(p + i - 8);
+	}
+
+	a ^= hash_wyp1;
+	b ^= seed;
+	hash_multiply(a, b);
+}
+
+inline uint64_t hash_short64(const unsigned char* const p, const std::size_t size, const uint64_t seed) noexcept
+{
+	uint64_t a, b;
+	hash_short(p, size, seed, a, b);
+	return hash_mum(a ^ hash_wyp0 ^ size, b ^ hash_wyp1);
+}
+
+inline hash128_value hash_short128(const unsigned char* const p, const std::size_t size, const uint64_t seed) noexcept
+{
+	uint64_t a, b;
+	hash_short(p, size, seed, a, b);
+	return hash128_value{ hash_mum(a ^ hash_wyp0 ^ size, b ^ hash_wyp1), hash_mum(a ^ hash_wyp2 ^ size, b ^ hash_wyp3) };
+}
+} //end namespace detail
+
+inline uint64_t hash64(const void* const data, const std::size_t size, const uint64_t seed = 0) noexcept
+{
+	const unsigned char* const p = static_cast<const unsigned char*>(data);
+	return size <= detail::hash_short_limit ? detail::hash_short64(p, size, seed) : detail::hash_long(p, size, seed).low;
+}
+
+inline hash128_value hash128(const void* const data, const std::size_t size, const uint64_t seed = 0) noexcept
+{
+	const unsigned char* const p = static_cast<const unsigned char*>(data);
+	return size <= detail::hash_short_limit ? detail::hash_short128(p, size, seed) : detail::hash_long(p, size, seed);
+}
+
+class hasher
+{
+public:
+	explicit hasher(const uint64_t seed = 0) noexcept
+	{
+		reset(seed);
+	}
+
+	void reset(const uint64_t seed = 0) noexcept
+	{
+		m_seed = seed;
+		m_total = 0;
+		m_count = 0;
+		m_buffered = 0;
+		detail::hash_seed_secret(seed, m_secret);
+		detail::hash_init_lanes(m_lanes);
+	}
+
+	//Whole buffers are only folded once more input follows, the last
+	//byte always stays behind for the final stripe.
+	void update(const void* const data, std::size_t size) noexcept
+	{
+		const unsigned char* p = static_cast<const unsigned char*>(data);
+		m_total += size;
+
+		while (size > 0)
+		{
+			if (m_buffered == buffer_size)
+			{
+				consume(m_buffer, buffer_size);
+				m_buffered = 0;
+			}
+
+			if (m_buffered == 0 && size > buffer_size)
+			{
+				const std::size_t direct = (size - 1) / buffer_size * buffer_size;
+				consume(p, direct);
+				p += direct;
+				size -= direct;
+			}
+
+			const std::size_t take = (size < buffer_size - m_buffered) ? size : buffer_size - m_buffered;
+			std::memcpy(m_buffer + m_buffered, p, take);
+			m_buffered += take;
+			p += take;
+			size -= take;
+		}
+	}
+
+	uint64_t final64() const noexcept
+	{
+		if (m_total <= detail::hash_short_limit)
+			return detail::hash_short64(m_buffer, m_buffered, m_seed);
+
+		return final_long().low;
+	}
+
+	hash128_value final128() const noexcept
+	{
+		if (m_total <= detail::hash_short_limit)
+			return detail::hash_short128(m_buffer, m_buffered, m_seed);
+
+		return final_long();
+	}
+
+private:
+	static constexpr std::size_t buffer_size = detail::hash_short_limit;
+
+	void consume(const unsigned char* const data, const std::size_t size) noexcept
+	{
+		detail::hash_consume(m_lanes, data, size / detail::hash_stripe, m_count, m_secret);
+		std::memcpy(m_last, data + size - detail::hash_stripe, detail::hash_stripe);
+	}
+
+	hash128_value final_long() const noexcept
+	{
+		uint64_t lanes[8];
+		uint64_t count = m_count;
+		unsigned char last[detail::hash_stripe];
+
+		std::memcpy(lanes, m_lanes, sizeof(lanes));
+		detail::hash_consume(lanes, m_buffer, (m_buffered - 1) / detail::hash_stripe, count, m_secret);
+
+		if (m_buffered >= detail::hash_stripe)
+			return detail::hash_long_digest(lanes, m_buffer + m_buffered - detail::hash_stripe, m_total, m_secret);
+
+		//The last stripe starts in the data folded before the buffer.
+		std::memcpy(last, m_last + m_buffered, detail::hash_stripe - m_buffered);
+		std::memcpy(last + detail::hash_stripe - m_buffered, m_buffer, m_buffered);
+		return detail::hash_long_digest(lanes, last, m_total, m_secret);
+	}
+
+	uint64_t m_seed;
+	uint64_t m_total;
+	uint64_t m_count;
+	std::size_t m_buffered;
+	uint64_t m_secret[detail::hash_secret_words];
+	uint64_t m_lanes[8];
+	unsigned char m_buffer[buffer_size];
+	unsigned char m_last[detail::hash_stripe];
+};
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
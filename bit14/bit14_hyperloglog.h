@@ -0,0 +1,363 @@
+//bit14_hyperloglog.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	bit14::hyperloglog<P> estimates the number of distinct 64 bit hashes
+|||	it has seen with 2^P registers (4 <= P <= 18), a standard error of
+|||	about 1.04 / sqrt(2^P), 0.81% for P = 14:
+|||
+|||		void insert(uint64_t hash);
+|||		void insert(const uint64_t* hashes, std::size_t n);
+|||		void merge(const hyperloglog& other);
+|||		double estimate() const;
+|||		bool sparse() const noexcept;
+|||		void clear() noexcept;
+|||		std::size_t size_in_bytes() const noexcept;
+|||
+|||	The inputs must already be well mixed hashes. The top P bits pick a
+|||	register, which keeps the maximum of countl_zero(hash << P) + 1.
+|||	A sentinel bit below the shifted hash caps the rank at 65 - P.
+|||
+|||	A new sketch is sparse: it logs (register, rank) pairs in a vector
+|||	that is sorted and deduplicated whenever it reaches 2^P / 4 entries,
+|||	and becomes dense (one byte per register) once a deduplicated log
+|||	still holds 2^P / 8 registers. Both forms use at most 2^P bytes.
+|||
+|||	The estimate is linear counting over the zero registers while that
+|||	gives at most 3 * 2^P. Past that point the bias of the harmonic mean
+|||	estimator is below its 1.04 / sqrt(2^P) error, so the harmonic mean
+|||	is used. Plain builds take the dense sums of 2^-rank from a lookup
+|||	table. AVX2 builds instead build each 2^-rank as the exponent field
+|||	of a double, four registers at a time. merge() takes the register
+|||	wise maximum with max_epu8 (AVX2 or SSE2). Sketches of equal P only.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <cmath>			//log
+#include <algorithm>		//sort
+#include <vector>			//vector
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+#if defined(BIT14_USING_SSE2) || defined(BIT14_USING_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace bit14
+{
+namespace detail
+{
+//2^-k for every register value.
+struct hll_inverse_powers
+{
+	double values[66];
+
+	constexpr hll_inverse_powers() : values()
+	{
+		double value = 1;
+
+		for (int k = 0; k < 66; ++k)
+		{
+			values[k] = value;
+			value /= 2;
+		}
+	}
+};
+
+inline const hll_inverse_powers& hll_inverse_power_table() noexcept
+{
+	static constexpr hll_inverse_powers table{};
+	return table;
+}
+
+//Sum of 2^-r over n registers and the number of zero registers.
+inline double hll_sum(const uint8_t* const registers, const std::size_t n, std::size_t& zeros) noexcept
+{
+	const hll_inverse_powers& table = hll_inverse_power_table();
+	double sum = 0;
+	std::size_t i = 0;
+	zeros = 0;
+
+#ifdef BIT14_USING_AVX2
+	const __m256i bias = _mm256_set1_epi64x(1023);
+	__m256d totals = _mm256_setzero_pd();
+
+	for (; i + 16 <= n; i += 16)
+	{
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(registers + i));
+		zeros += static_cast<std::size_t>(bit14::popcount(static_cast<unsigned int>(
+			_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_setzero_si128())))));
+
+		//Biased exponent 1023 - r in the top of every 64 bit lane is exactly 2^-r.
+		totals = _mm256_add_pd(totals, _mm256_castsi256_pd(_mm256_slli_epi64(
+			_mm256_sub_epi64(bias, _mm256_cvtepu8_epi64(bytes)), 52)));
+		totals = _mm256_add_pd(totals, _mm256_castsi256_pd(_mm256_slli_epi64(
+			_mm256_sub_epi64(bias, _mm256_cvtepu8_epi64(_mm_srli_si128(bytes, 4))), 52)));
+		totals = _mm256_add_pd(totals, _mm256_castsi256_pd(_mm256_slli_epi64(
+			_mm256_sub_epi64(bias, _mm256_cvtepu8_epi64(_mm_srli_si128(bytes, 8))), 52)));
+		totals = _mm256_add_pd(totals, _mm256_castsi256_pd(_mm256_slli_epi64(
+			_mm256_sub_epi64(bias, _mm256_cvtepu8_epi64(_mm_srli_si128(bytes, 12))), 52)));
+	}
+
+	double lanes[4];
+	_mm256_storeu_pd(lanes, totals);
+	sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+
+	for (; i < n; ++i)
+	{
+		sum += table.values[registers[i]];
+		zeros += (registers[i] == 0);
+	}
+
+	return sum;
+}
+
+//registers[i] = max(registers[i], other[i]).
+inline void hll_max(uint8_t* const registers, const uint8_t* const other, const std::size_t n) noexcept
+{
+	std::size_t i = 0;
+
+#if defined(BIT14_USING_AVX2)
+	for (; i + 32 <= n; i += 32)
+	{
+		__m256i* const target = reinterpret_cast<__m256i*>(registers + i);
+		_mm256_storeu_si256(target, _mm256_max_epu8(_mm256_loadu_si256(target),
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(other + i))));
+	}
+#elif defined(BIT14_USING_SSE2)
+	for (; i + 16 <= n; i += 16)
+	{
+		__m128i* const target = reinterpret_cast<__m128i*>(registers + i);
+		_mm_storeu_si128(target, _mm_max_epu8(_mm_loadu_si128(target),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(other + i))));
+	}
+#endif
+
+	for (; i < n; ++i)
+		registers[i] = registers[i] < other[i] ? other[i] : registers[i];
+}
+
+inline double hll_alpha(const std::size_t m) noexcept
+{
+	return m == 16 ? 0.673 : m == 32 ? 0.697 : m == 64 ? 0.709 : 0.7213 / (1 + 1.079 / static_cast<double>(m));
+}
+} //end namespace detail
+
+template <int P>
+class hyperloglog
+{
+	static_assert(P >= 4 && P <= 18, "bit14::hyperloglog requires a precision between 4 and 18.\n");
+
+public:
+	static constexpr std::size_t register_count = std::size_t{ 1 } << P;
+
+	bool sparse() const noexcept
+	{
+		return m_registers.empty();
+	}
+
+	std::size_t size_in_bytes() const noexcept
+	{
+		return m_registers.size() + m_log.size() * sizeof(uint32_t);
+	}
+
+	void clear() noexcept
+	{
+		std::vector<uint8_t>().swap(m_registers);
+		m_log.clear();
+	}
+
+	void insert(const uint64_t hash)
+	{
+		if (!sparse())
+		{
+			update(m_registers.data(), hash);
+			return;
+		}
+
+		m_log.push_back(static_cast<uint32_t>(index_of(hash) << 8) | rank_of(hash));
+
+		if (m_log.size() >= log_limit)
+			compact();
+	}
+
+	void insert(const uint64_t* const hashes, const std::size_t n)
+	{
+		std::size_t i = 0;
+
+		for (; i < n && sparse(); ++i)
+			insert(hashes[i]);
+
+		uint8_t* const registers = m_registers.data();
+
+		for (; i < n; ++i)
+			update(registers, hashes[i]);
+	}
+
+	void merge(const hyperloglog& other)
+	{
+		if (&other == this)
+			return;
+
+		if (other.sparse())
+		{
+			for (const uint32_t entry : other.m_log)
+			{
+				if (sparse())
+				{
+					m_log.push_back(entry);
+
+					if (m_log.size() >= log_limit)
+						compact();
+				}
+				else
+				{
+					uint8_t& value = m_registers[entry >> 8];
+					value = value < (entry & 0xFF) ? static_cast<uint8_t>(entry) : value;
+				}
+			}
+
+			return;
+		}
+
+		if (sparse())
+			densify();
+
+		detail::hll_max(m_registers.data(), other.m_registers.data(), register_count);
+	}
+
+	double estimate() const
+	{
+		const double m = static_cast<double>(register_count);
+		std::size_t zeros;
+		double sum;
+
+		if (sparse())
+		{
+			const std::vector<uint32_t> entries = normalized_log();
+			const detail::hll_inverse_powers& table = detail::hll_inverse_power_table();
+			zeros = register_count - entries.size();
+			sum = static_cast<double>(zeros);
+
+			for (const uint32_t entry : entries)
+				sum += table.values[entry & 0xFF];
+		}
+		else
+		{
+			sum = detail::hll_sum(m_registers.data(), register_count, zeros);
+		}
+
+		if (zeros != 0)
+		{
+			const double linear = m * std::log(m / static_cast<double>(zeros));
+
+			if (linear <= 3 * m)
+				return linear;
+		}
+
+		return detail::hll_alpha(register_count) * m * m / sum;
+	}
+
+private:
+	static constexpr std::size_t log_limit = register_count / 4;
+
+	static std::size_t index_of(const uint64_t hash) noexcept
+	{
+		return static_cast<std::size_t>(hash >> (64 - P));
+	}
+
+	static uint8_t rank_of(const uint64_t hash) noexcept
+	{
+		return static_cast<uint8_t>(bit14::countl_zero((hash << P) | (uint64_t{ 1 } << (P - 1))) + 1);
+	}
+
+	static void update(uint8_t* const registers, const uint64_t hash) noexcept
+	{
+		uint8_t& value = registers[index_of(hash)];
+		const uint8_t rank = rank_of(hash);
+		value = value < rank ? rank : value;
+	}
+
+	//Sorted log entries with one entry, the highest rank, per register.
+	std::vector<uint32_t> normalized_log() const
+	{
+		std::vector<uint32_t> entries(m_log);
+		std::sort(entries.begin(), entries.end());
+		std::size_t kept = 0;
+
+		for (std::size_t i = 0; i < entries.size(); ++i)
+		{
+			if (i + 1 < entries.size() && (entries[i + 1] >> 8) == (entries[i] >> 8))
+				continue;
+
+			entries[kept++] = entries[i];
+		}
+
+		entries.resize(kept);
+		return entries;
+	}
+
+	void compact()
+	{
+		m_log = normalized_log();
+
+		if (m_log.size() >= register_count / 8)
+			densify();
+	}
+
+	void densify()
+	{
+		m_registers.assign(register_count, 0);
+
+		for (const uint32_t entry : m_log)
+		{
+			uint8_t& value = m_registers[entry >> 8];
+			value = value < (entry & 0xFF) ? static_cast<uint8_t>(entry) : value;
+		}
+
+		m_log.clear();
+		m_log.shrink_to_fit();
+	}
+
+	std::vector<uint8_t> m_registers;
+	std::vector<uint32_t> m_log;
+};
+
+template <int P>
+constexpr std::size_t hyperloglog<P>::register_count;
+
+template <int P>
+constexpr std::size_t hyperloglog<P>::log_limit;
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
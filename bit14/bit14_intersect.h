@@ -0,0 +1,341 @@
+//bit14_intersect.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	Intersection of two sorted uint32_t sets (strictly increasing
+|||	arrays), writing the common values in order:
+|||
+|||		std::size_t intersect(const uint32_t* a, std::size_t na,
+|||			const uint32_t* b, std::size_t nb, uint32_t* out) noexcept;
+|||		std::size_t intersect_count(const uint32_t* a, std::size_t na,
+|||			const uint32_t* b, std::size_t nb) noexcept;
+|||
+|||	Both return the size of the intersection, out must have room for
+|||	min(na, nb) values. intersect_count() runs the same algorithms
+|||	without storing anything.
+|||
+|||	When one set is at least intersect_skew_ratio (32) times larger,
+|||	every element of the smaller set gallops through the larger one
+|||	(exponential then binary search). Otherwise blocks of both sets
+|||	are compared all against all: 8 x 8 with AVX2, 4 x 4 with SSSE3,
+|||	by comparing one block with every rotation of the other. The
+|||	movemask of the matches is counted with bit14::popcount and
+|||	selects a shuffle that packs the matching values to the front of
+|||	the output. The block with the smaller last value advances. Plain
+|||	builds and the tails of the blocked loop use a branchless merge.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+#if defined(BIT14_USING_SSSE3) || defined(BIT14_USING_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace bit14
+{
+constexpr std::size_t intersect_skew_ratio = 32;
+
+namespace detail
+{
+//Byte positions of the set lanes of a 4 bit (x 4 bytes) or 8 bit (x 1 lane) mask, packed to the front.
+struct intersect_tables
+{
+	unsigned char shuffle4[16][16];
+	unsigned char permute8[256][8];
+
+	constexpr intersect_tables() : shuffle4(), permute8()
+	{
+		for (int mask = 0; mask < 16; ++mask)
+		{
+			int out = 0;
+
+			for (int lane = 0; lane < 4; ++lane)
+			{
+				if ((mask >> lane) & 1)
+				{
+					for (int b = 0; b < 4; ++b)
+						shuffle4[mask][4 * out + b] = static_cast<unsigned char>(4 * lane + b);
+
+					++out;
+				}
+			}
+
+			for (; out < 4; ++out)
+			{
+				for (int b = 0; b < 4; ++b)
+					shuffle4[mask][4 * out + b] = 0x80;
+			}
+		}
+
+		for (int mask = 0; mask < 256; ++mask)
+		{
+			int out = 0;
+
+			for (int lane = 0; lane < 8; ++lane)
+			{
+				if ((mask >> lane) & 1)
+					permute8[mask][out++] = static_cast<unsigned char>(lane);
+			}
+		}
+	}
+};
+
+inline const intersect_tables& intersect_table() noexcept
+{
+	static constexpr intersect_tables tables{};
+	return tables;
+}
+
+//Writes the values of a selected by mask, unless Write is false.
+template <bool Write>
+std::size_t intersect_emit(const uint32_t* values, unsigned int mask, uint32_t* out) noexcept
+{
+	std::size_t count = 0;
+
+	for (; mask; mask &= mask - 1)
+	{
+		if (Write)
+			out[count] = values[bit14::countr_zero(mask)];
+
+		++count;
+	}
+
+	return count;
+}
+
+template <bool Write>
+std::size_t intersect_merge(const uint32_t* a, std::size_t i, const std::size_t na,
+	const uint32_t* b, std::size_t j, const std::size_t nb, uint32_t* out) noexcept
+{
+	std::size_t count = 0;
+
+	//out[count] is only overwritten while a value may still follow, so it never passes min(na, nb).
+	while (i < na && j < nb)
+	{
+		const uint32_t x = a[i];
+		const uint32_t y = b[j];
+
+		if (Write)
+			out[count] = x;
+
+		count += (x == y);
+		i += (x <= y);
+		j += (y <= x);
+	}
+
+	return count;
+}
+
+template <bool Write>
+std::size_t intersect_gallop(const uint32_t* small, const std::size_t ns,
+	const uint32_t* large, const std::size_t nl, uint32_t* out) noexcept
+{
+	std::size_t count = 0;
+	std::size_t j = 0;
+
+	for (std::size_t i = 0; i < ns && j < nl; ++i)
+	{
+		const uint32_t x = small[i];
+
+		if (large[j] < x)
+		{
+			std::size_t step = 1;
+
+			while (j + step < nl && large[j + step] < x)
+				step <<= 1;
+
+			//large[j + step / 2] < x, the answer lies in (j + step / 2, min(j + step, nl)].
+			std::size_t base = j + step / 2;
+			std::size_t length = ((j + step < nl) ? j + step : nl) - base;
+
+			while (length > 1)
+			{
+				const std::size_t half = length / 2;
+				base = (large[base + half] < x) ? base + half : base;
+				length -= half;
+			}
+
+			j = base + 1;
+
+			if (j == nl)
+				break;
+		}
+
+		if (large[j] == x)
+		{
+			if (Write)
+				out[count] = x;
+
+			++count;
+			++j;
+		}
+	}
+
+	return count;
+}
+
+#ifdef BIT14_USING_AVX2
+template <bool Write>
+std::size_t intersect_blocks(const uint32_t* a, const std::size_t na, const uint32_t* b, const std::size_t nb,
+	uint32_t* out) noexcept
+{
+	const intersect_tables& table = intersect_table();
+	const std::size_t room = na < nb ? na : nb;
+	const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+	std::size_t count = 0;
+	std::size_t i = 0;
+	std::size_t j = 0;
+
+	while (i + 8 <= na && j + 8 <= nb)
+	{
+		const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+		__m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+		__m256i matches = _mm256_cmpeq_epi32(va, vb);
+
+		for (int r = 1; r < 8; ++r)
+		{
+			vb = _mm256_permutevar8x32_epi32(vb, rotate);
+			matches = _mm256_or_si256(matches, _mm256_cmpeq_epi32(va, vb));
+		}
+
+		const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(matches)));
+
+		if (!Write)
+		{
+			count += static_cast<std::size_t>(bit14::popcount(mask));
+		}
+		else if (count + 8 <= room)
+		{
+			const __m256i order = _mm256_cvtepu8_epi32(
+				_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.permute8[mask])));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + count), _mm256_permutevar8x32_epi32(va, order));
+			count += static_cast<std::size_t>(bit14::popcount(mask));
+		}
+		else
+		{
+			count += intersect_emit<Write>(a + i, mask, out + count);
+		}
+
+		const uint32_t last_a = a[i + 7];
+		const uint32_t last_b = b[j + 7];
+		i += (last_a <= last_b) ? 8 : 0;
+		j += (last_b <= last_a) ? 8 : 0;
+	}
+
+	return count + intersect_merge<Write>(a, i, na, b, j, nb, out + count);
+}
+#elif defined(BIT14_USING_SSSE3)
+template <bool Write>
+std::size_t intersect_blocks(const uint32_t* a, const std::size_t na, const uint32_t* b, const std::size_t nb,
+	uint32_t* out) noexcept
+{
+	const intersect_tables& table = intersect_table();
+	const std::size_t room = na < nb ? na : nb;
+	std::size_t count = 0;
+	std::size_t i = 0;
+	std::size_t j = 0;
+
+	while (i + 4 <= na && j + 4 <= nb)
+	{
+		const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+		const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+		const __m128i matches = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39))),
+			_mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4E)),
+				_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93))));
+		const unsigned int mask = static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(matches)));
+
+		if (!Write)
+		{
+			count += static_cast<std::size_t>(bit14::popcount(mask));
+		}
+		else if (count + 4 <= room)
+		{
+			const __m128i order = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.shuffle4[mask]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + count), _mm_shuffle_epi8(va, order));
+			count += static_cast<std::size_t>(bit14::popcount(mask));
+		}
+		else
+		{
+			count += intersect_emit<Write>(a + i, mask, out + count);
+		}
+
+		const uint32_t last_a = a[i + 3];
+		const uint32_t last_b = b[j + 3];
+		i += (last_a <= last_b) ? 4 : 0;
+		j += (last_b <= last_a) ? 4 : 0;
+	}
+
+	return count + intersect_merge<Write>(a, i, na, b, j, nb, out + count);
+}
+#else
+template <bool Write>
+std::size_t intersect_blocks(const uint32_t* a, const std::size_t na, const uint32_t* b, const std::size_t nb,
+	uint32_t* out) noexcept
+{
+	return intersect_merge<Write>(a, 0, na, b, 0, nb, out);
+}
+#endif
+
+template <bool Write>
+std::size_t intersect(const uint32_t* a, const std::size_t na, const uint32_t* b, const std::size_t nb,
+	uint32_t* out) noexcept
+{
+	if (na == 0 || nb == 0)
+		return 0;
+
+	if (na / intersect_skew_ratio >= nb)
+		return intersect_gallop<Write>(b, nb, a, na, out);
+
+	if (nb / intersect_skew_ratio >= na)
+		return intersect_gallop<Write>(a, na, b, nb, out);
+
+	return intersect_blocks<Write>(a, na, b, nb, out);
+}
+} //end namespace detail
+
+inline std::size_t intersect(const uint32_t* a, const std::size_t na, const uint32_t* b, const std::size_t nb,
+	uint32_t* out) noexcept
+{
+	return detail::intersect<true>(a, na, b, nb, out);
+}
+
+inline std::size_t intersect_count(const uint32_t* a, const std::size_t na, const uint32_t* b,
+	const std::size_t nb) noexcept
+{
+	return detail::intersect<false>(a, na, b, nb, nullptr);
+}
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
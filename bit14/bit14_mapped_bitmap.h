@@ -0,0 +1,368 @@
+//bit14_mapped_bitmap.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	An on disk bitmap format that is queried in place, for example
+|||	straight from a read only memory mapping of the file.
+|||
+|||	bit14::make_mapped_bitmap() writes the format, bit14::mapped_bitmap
+|||	reads it without copying. Files are written in the byte order of the
+|||	writer and mapped_bitmap applies bit14::byteswap to every word it
+|||	reads only when that order differs from bit14::endian::native.
+|||
+|||		std::vector<unsigned char> make_mapped_bitmap(const uint64_t* words,
+|||			uint64_t bit_count, bool rank_index = true, bool checksums = true);
+|||
+|||		bool open(const void* data, std::size_t size) noexcept;
+|||		uint64_t size() const noexcept;					//bits
+|||		bool test(uint64_t i) const noexcept;
+|||		uint64_t word(uint64_t i) const noexcept;
+|||		uint64_t count() const noexcept;
+|||		uint64_t rank(uint64_t i) const noexcept;		//set bits before i
+|||		bool has_rank_index() const noexcept;
+|||		bool has_checksums() const noexcept;
+|||		bool verify_block(uint64_t block) const noexcept;
+|||		bool verify() const noexcept;
+|||
+|||	Layout, all offsets in bytes from the start of the file:
+|||
+|||		0	char magic[8]				"BIT14BM"
+|||		8	uint32_t byte_order_mark	0x01020304 in the writer's order
+|||		12	uint16_t version			1
+|||		14	uint16_t flags				1 rank index, 2 checksums
+|||		16	uint64_t bit_count
+|||		24	uint64_t word_count
+|||		32	uint64_t words_offset		64, the header size
+|||		40	uint64_t rank_offset		0 without a rank index
+|||		48	uint64_t checksum_offset	0 without checksums
+|||		56	uint32_t block_words		words per checksum block
+|||		60	uint32_t reserved
+|||
+|||	Every section starts on a 64 byte boundary. The rank index holds
+|||	one uint64_t per 512 bit superblock, the number of set bits before
+|||	it, so rank() reads one index entry and at most 8 words. Checksums
+|||	hold one uint64_t per block of block_words words, computed over the
+|||	word values and therefore identical in both byte orders.
+|||
+|||	open() checks the header and that every section lies inside the
+|||	data, it does not read the words. verify() checks all blocks.
+|||	The data must stay mapped while the mapped_bitmap is in use.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <cstring>			//memcpy, memcmp
+#include <vector>			//vector
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+namespace detail
+{
+constexpr char mapped_bitmap_magic[8] = { 'B', 'I', 'T', '1', '4', 'B', 'M', '\0' };
+constexpr uint32_t mapped_bitmap_order_mark = 0x01020304;
+constexpr uint16_t mapped_bitmap_version = 1;
+constexpr uint16_t mapped_bitmap_rank_flag = 1;
+constexpr uint16_t mapped_bitmap_checksum_flag = 2;
+constexpr std::size_t mapped_bitmap_header_size = 64;
+constexpr uint32_t mapped_bitmap_block_words = 512;
+constexpr uint64_t mapped_bitmap_superblock_words = 8;
+
+inline uint64_t mapped_bitmap_align(const uint64_t offset) noexcept
+{
+	return (offset + 63) & ~uint64_t{ 63 };
+}
+
+//Checksums start from a seed that depends on the block index, so blocks that trade places are caught.
+inline uint64_t mapped_bitmap_seed(const uint64_t block) noexcept
+{
+	return 0x243F6A8885A308D3ull ^ (block * 0xD1B54A32D192ED03ull);
+}
+
+inline uint64_t mapped_bitmap_mix(uint64_t state, const uint64_t word) noexcept
+{
+	state ^= word;
+	state *= 0x9E3779B97F4A7C15ull;
+	return state ^ (state >> 29);
+}
+
+template <typename T>
+void mapped_bitmap_store(std::vector<unsigned char>& out, const uint64_t offset, const T value) noexcept
+{
+	std::memcpy(&out[static_cast<std::size_t>(offset)], &value, sizeof(T));
+}
+} //end namespace detail
+
+inline std::vector<unsigned char> make_mapped_bitmap(const uint64_t* const words, const uint64_t bit_count,
+	const bool rank_index = true, const bool checksums = true)
+{
+	const uint64_t word_count = (bit_count + 63) / 64;
+	const uint64_t superblocks = (word_count + detail::mapped_bitmap_superblock_words - 1) / detail::mapped_bitmap_superblock_words;
+	const uint64_t blocks = (word_count + detail::mapped_bitmap_block_words - 1) / detail::mapped_bitmap_block_words;
+	const uint64_t words_offset = detail::mapped_bitmap_header_size;
+	const uint64_t rank_offset = rank_index ? detail::mapped_bitmap_align(words_offset + 8 * word_count) : 0;
+	const uint64_t checksum_offset = checksums ?
+		detail::mapped_bitmap_align((rank_index ? rank_offset + 8 * superblocks : words_offset + 8 * word_count)) : 0;
+	const uint64_t end = checksums ? checksum_offset + 8 * blocks :
+		(rank_index ? rank_offset + 8 * superblocks : words_offset + 8 * word_count);
+	const uint16_t flags = static_cast<uint16_t>((rank_index ? detail::mapped_bitmap_rank_flag : 0) |
+		(checksums ? detail::mapped_bitmap_checksum_flag : 0));
+
+	std::vector<unsigned char> out(static_cast<std::size_t>(end), 0);
+	std::memcpy(out.data(), detail::mapped_bitmap_magic, sizeof(detail::mapped_bitmap_magic));
+	detail::mapped_bitmap_store(out, 8, detail::mapped_bitmap_order_mark);
+	detail::mapped_bitmap_store(out, 12, detail::mapped_bitmap_version);
+	detail::mapped_bitmap_store(out, 14, flags);
+	detail::mapped_bitmap_store(out, 16, bit_count);
+	detail::mapped_bitmap_store(out, 24, word_count);
+	detail::mapped_bitmap_store(out, 32, words_offset);
+	detail::mapped_bitmap_store(out, 40, rank_offset);
+	detail::mapped_bitmap_store(out, 48, checksum_offset);
+	detail::mapped_bitmap_store(out, 56, detail::mapped_bitmap_block_words);
+
+	uint64_t ones = 0;
+	uint64_t checksum = 0;
+
+	for (uint64_t i = 0; i < word_count; ++i)
+	{
+		//Bits past bit_count are stored as zero.
+		const uint64_t tail = bit_count % 64;
+		const uint64_t word = (i + 1 == word_count && tail) ? words[i] & ((uint64_t{ 1 } << tail) - 1) : words[i];
+
+		if (rank_index && i % detail::mapped_bitmap_superblock_words == 0)
+			detail::mapped_bitmap_store(out, rank_offset + 8 * (i / detail::mapped_bitmap_superblock_words), ones);
+
+		if (i % detail::mapped_bitmap_block_words == 0)
+			checksum = detail::mapped_bitmap_seed(i / detail::mapped_bitmap_block_words);
+
+		detail::mapped_bitmap_store(out, words_offset + 8 * i, word);
+		ones += static_cast<uint64_t>(bit14::popcount(word));
+		checksum = detail::mapped_bitmap_mix(checksum, word);
+
+		if (checksums && (i + 1) % detail::mapped_bitmap_block_words == 0)
+			detail::mapped_bitmap_store(out, checksum_offset + 8 * (i / detail::mapped_bitmap_block_words), checksum);
+	}
+
+	if (checksums && word_count % detail::mapped_bitmap_block_words)
+		detail::mapped_bitmap_store(out, checksum_offset + 8 * (blocks - 1), checksum);
+
+	return out;
+}
+
+class mapped_bitmap
+{
+public:
+	mapped_bitmap() noexcept
+		: m_data(nullptr), m_swap(false), m_flags(0), m_bit_count(0), m_word_count(0),
+		m_words_offset(0), m_rank_offset(0), m_checksum_offset(0), m_block_words(0) {}
+
+	bool open(const void* const data, const std::size_t size) noexcept
+	{
+		*this = mapped_bitmap();
+		const unsigned char* const bytes = static_cast<const unsigned char*>(data);
+
+		if (size < detail::mapped_bitmap_header_size ||
+			std::memcmp(bytes, detail::mapped_bitmap_magic, sizeof(detail::mapped_bitmap_magic)) != 0)
+			return false;
+
+		const uint32_t mark = raw<uint32_t>(bytes + 8);
+
+		if (mark != detail::mapped_bitmap_order_mark && bit14::byteswap(mark) != detail::mapped_bitmap_order_mark)
+			return false;
+
+		m_swap = (mark != detail::mapped_bitmap_order_mark);
+		m_data = bytes;
+
+		const uint16_t version = field<uint16_t>(12);
+		m_flags = field<uint16_t>(14);
+		m_bit_count = field<uint64_t>(16);
+		m_word_count = field<uint64_t>(24);
+		m_words_offset = field<uint64_t>(32);
+		m_rank_offset = field<uint64_t>(40);
+		m_checksum_offset = field<uint64_t>(48);
+		m_block_words = field<uint32_t>(56);
+
+		const uint64_t superblocks = (m_word_count + detail::mapped_bitmap_superblock_words - 1) / detail::mapped_bitmap_superblock_words;
+		const bool valid = version == detail::mapped_bitmap_version &&
+			m_word_count == (m_bit_count + 63) / 64 &&
+			section_fits(m_words_offset, m_word_count, size) &&
+			(!has_rank_index() || section_fits(m_rank_offset, superblocks, size)) &&
+			(!has_checksums() || (m_block_words != 0 && section_fits(m_checksum_offset, block_count(), size)));
+
+		if (!valid)
+			*this = mapped_bitmap();
+
+		return valid;
+	}
+
+	uint64_t size() const noexcept
+	{
+		return m_bit_count;
+	}
+
+	bool has_rank_index() const noexcept
+	{
+		return (m_flags & detail::mapped_bitmap_rank_flag) != 0;
+	}
+
+	bool has_checksums() const noexcept
+	{
+		return (m_flags & detail::mapped_bitmap_checksum_flag) != 0;
+	}
+
+	uint64_t word(const uint64_t i) const noexcept
+	{
+		return field<uint64_t>(m_words_offset + 8 * i);
+	}
+
+	bool test(const uint64_t i) const noexcept
+	{
+		return (word(i / 64) >> (i % 64)) & 1;
+	}
+
+	uint64_t count() const noexcept
+	{
+		if (has_rank_index() && m_word_count != 0)
+			return rank(m_bit_count);
+
+		uint64_t result = 0;
+
+		for (uint64_t i = 0; i < m_word_count; ++i)
+			result += static_cast<uint64_t>(bit14::popcount(word(i)));
+
+		return result;
+	}
+
+	//Number of set bits in [0, i), i may equal size().
+	uint64_t rank(const uint64_t i) const noexcept
+	{
+		const uint64_t last_word = i / 64;
+		uint64_t first_word = 0;
+		uint64_t result = 0;
+
+		if (has_rank_index())
+		{
+			const uint64_t superblock = last_word / detail::mapped_bitmap_superblock_words;
+
+			if (superblock * detail::mapped_bitmap_superblock_words < m_word_count)
+			{
+				first_word = superblock * detail::mapped_bitmap_superblock_words;
+				result = field<uint64_t>(m_rank_offset + 8 * superblock);
+			}
+			else
+				return count_words(0, m_word_count);
+		}
+
+		result += count_words(first_word, last_word);
+
+		if (i % 64)
+			result += static_cast<uint64_t>(bit14::popcount(word(last_word) & ((uint64_t{ 1 } << (i % 64)) - 1)));
+
+		return result;
+	}
+
+	uint64_t block_count() const noexcept
+	{
+		return m_block_words ? (m_word_count + m_block_words - 1) / m_block_words : 0;
+	}
+
+	bool verify_block(const uint64_t block) const noexcept
+	{
+		if (!has_checksums() || block >= block_count())
+			return false;
+
+		const uint64_t first = block * m_block_words;
+		const uint64_t last = (first + m_block_words < m_word_count) ? first + m_block_words : m_word_count;
+		uint64_t checksum = detail::mapped_bitmap_seed(block);
+
+		for (uint64_t i = first; i < last; ++i)
+			checksum = detail::mapped_bitmap_mix(checksum, word(i));
+
+		return checksum == field<uint64_t>(m_checksum_offset + 8 * block);
+	}
+
+	bool verify() const noexcept
+	{
+		for (uint64_t block = 0; block < block_count(); ++block)
+		{
+			if (!verify_block(block))
+				return false;
+		}
+
+		return has_checksums();
+	}
+
+private:
+	template <typename T>
+	static T raw(const unsigned char* const src) noexcept
+	{
+		T value;
+		std::memcpy(&value, src, sizeof(T));
+		return value;
+	}
+
+	template <typename T>
+	T field(const uint64_t offset) const noexcept
+	{
+		const T value = raw<T>(m_data + offset);
+		return m_swap ? bit14::byteswap(value) : value;
+	}
+
+	static bool section_fits(const uint64_t offset, const uint64_t words, const std::size_t size) noexcept
+	{
+		return offset >= detail::mapped_bitmap_header_size && offset % 64 == 0 &&
+			offset <= size && words <= (size - offset) / 8;
+	}
+
+	uint64_t count_words(uint64_t first, const uint64_t last) const noexcept
+	{
+		uint64_t result = 0;
+
+		for (; first < last; ++first)
+			result += static_cast<uint64_t>(bit14::popcount(word(first)));
+
+		return result;
+	}
+
+	const unsigned char* m_data;
+	bool m_swap;
+	uint16_t m_flags;
+	uint64_t m_bit_count;
+	uint64_t m_word_count;
+	uint64_t m_words_offset;
+	uint64_t m_rank_offset;
+	uint64_t m_checksum_offset;
+	uint32_t m_block_words;
+};
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
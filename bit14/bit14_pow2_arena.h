@@ -0,0 +1,345 @@
+//bit14_pow2_arena.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	Power of two size class allocation on top of bit14::bit_width.
+|||
+|||	bit14::pow2_arena is a bump allocator over large blocks obtained
+|||	from operator new. Memory is only returned all at once by release()
+|||	or the destructor.
+|||
+|||		explicit pow2_arena(std::size_t block_size = 65536);
+|||		void* allocate(std::size_t size, std::size_t align = alignof(std::max_align_t));
+|||		void release() noexcept;
+|||		std::size_t reserved() const noexcept;
+|||
+|||	bit14::size_class_pool rounds every request up to a power of two
+|||	size class, bit_width(n - 1), between 2^min_class and 2^max_class
+|||	bytes. Each class keeps a free list of returned chunks, new chunks
+|||	are carved from a pow2_arena. Larger requests go to operator new
+|||	directly. The pool is shared between threads behind a mutex.
+|||
+|||		explicit size_class_pool(std::size_t arena_block_size = 1 << 20);
+|||		void* allocate(std::size_t size);
+|||		void deallocate(void* ptr, std::size_t size) noexcept;
+|||		void release() noexcept;
+|||		static int size_class(std::size_t size) noexcept;
+|||		static std::size_t class_size(int size_class) noexcept;
+|||
+|||	bit14::size_class_cache is a per thread front end to a pool. It
+|||	keeps up to cache_depth chunks per class and moves them to and from
+|||	the pool in batches, so most calls take no lock. Chunks may be
+|||	freed through any cache or the pool itself as long as the size is
+|||	the one they were allocated with.
+|||
+|||		explicit size_class_cache(size_class_pool& pool) noexcept;
+|||		void* allocate(std::size_t size);
+|||		void deallocate(void* ptr, std::size_t size) noexcept;
+|||		void flush() noexcept;
+|||
+|||	size_class_pool::release() drops every chunk at once. Caches of
+|||	that pool must be flushed first and chunks larger than the biggest
+|||	class must still be deallocated one by one.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t, max_align_t
+#include <cstdint>			//uintptr_t
+#include <mutex>			//mutex, lock_guard
+#include <new>				//operator new, operator delete
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+class pow2_arena
+{
+public:
+	explicit pow2_arena(const std::size_t block_size = 65536) noexcept
+		: m_blocks(nullptr), m_cursor(nullptr), m_end(nullptr), m_block_size(block_size), m_reserved(0) {}
+
+	pow2_arena(const pow2_arena&) = delete;
+	pow2_arena& operator=(const pow2_arena&) = delete;
+
+	~pow2_arena()
+	{
+		release();
+	}
+
+	//align must be a power of two.
+	void* allocate(const std::size_t size, const std::size_t align = alignof(std::max_align_t))
+	{
+		char* result = align_up(m_cursor, align);
+
+		if (m_cursor == nullptr || result > m_end || size > static_cast<std::size_t>(m_end - result))
+		{
+			const std::size_t needed = size + align + sizeof(block_header);
+
+			//Requests that would waste most of a fresh block get a block of their own.
+			if (needed > m_block_size / 2)
+				return align_up(new_block(needed), align);
+
+			m_cursor = new_block(m_block_size);
+			m_end = m_cursor + (m_block_size - sizeof(block_header));
+			result = align_up(m_cursor, align);
+		}
+
+		m_cursor = result + size;
+		return result;
+	}
+
+	void release() noexcept
+	{
+		while (m_blocks)
+		{
+			block_header* const next = m_blocks->next;
+			::operator delete(m_blocks);
+			m_blocks = next;
+		}
+
+		m_cursor = nullptr;
+		m_end = nullptr;
+		m_reserved = 0;
+	}
+
+	std::size_t reserved() const noexcept
+	{
+		return m_reserved;
+	}
+
+private:
+	struct alignas(std::max_align_t) block_header
+	{
+		block_header* next;
+	};
+
+	static char* align_up(char* const ptr, const std::size_t align) noexcept
+	{
+		const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(ptr);
+		return ptr + ((align - (address & (align - 1))) & (align - 1));
+	}
+
+	char* new_block(const std::size_t size)
+	{
+		block_header* const block = static_cast<block_header*>(::operator new(size));
+		block->next = m_blocks;
+		m_blocks = block;
+		m_reserved += size;
+		return reinterpret_cast<char*>(block + 1);
+	}
+
+	block_header* m_blocks;
+	char* m_cursor;
+	char* m_end;
+	std::size_t m_block_size;
+	std::size_t m_reserved;
+};
+
+class size_class_pool
+{
+public:
+	static constexpr int min_class = 4;
+	static constexpr int max_class = 16;
+	static constexpr int class_count = max_class - min_class + 1;
+
+	explicit size_class_pool(const std::size_t arena_block_size = std::size_t{ 1 } << 20) noexcept
+		: m_arena(arena_block_size)
+	{
+		for (free_node*& head : m_free)
+			head = nullptr;
+	}
+
+	size_class_pool(const size_class_pool&) = delete;
+	size_class_pool& operator=(const size_class_pool&) = delete;
+
+	//Class of a request, values above max_class are not pooled.
+	static int size_class(const std::size_t size) noexcept
+	{
+		const int width = bit14::bit_width(size - (size != 0));
+		return width < min_class ? min_class : width;
+	}
+
+	static std::size_t class_size(const int size_class) noexcept
+	{
+		return std::size_t{ 1 } << size_class;
+	}
+
+	void* allocate(const std::size_t size)
+	{
+		const int size_class = this->size_class(size);
+
+		if (size_class > max_class)
+			return ::operator new(size);
+
+		void* result;
+		take(size_class, &result, 1);
+		return result;
+	}
+
+	void deallocate(void* const ptr, const std::size_t size) noexcept
+	{
+		const int size_class = this->size_class(size);
+
+		if (size_class > max_class)
+			::operator delete(ptr);
+		else
+			give(size_class, &ptr, 1);
+	}
+
+	void release() noexcept
+	{
+		const std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (free_node*& head : m_free)
+			head = nullptr;
+
+		m_arena.release();
+	}
+
+	//Fills out with count chunks of size_class, reusing freed chunks first.
+	void take(const int size_class, void** const out, const std::size_t count)
+	{
+		const std::lock_guard<std::mutex> lock(m_mutex);
+		free_node*& head = m_free[size_class - min_class];
+		std::size_t i = 0;
+
+		for (; i < count && head != nullptr; ++i)
+		{
+			out[i] = head;
+			head = head->next;
+		}
+
+		const std::size_t size = class_size(size_class);
+
+		for (; i < count; ++i)
+			out[i] = m_arena.allocate(size, size < alignof(std::max_align_t) ? size : alignof(std::max_align_t));
+	}
+
+	void give(const int size_class, void* const* const in, const std::size_t count) noexcept
+	{
+		const std::lock_guard<std::mutex> lock(m_mutex);
+		free_node*& head = m_free[size_class - min_class];
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			free_node* const node = static_cast<free_node*>(in[i]);
+			node->next = head;
+			head = node;
+		}
+	}
+
+private:
+	struct free_node
+	{
+		free_node* next;
+	};
+
+	std::mutex m_mutex;
+	pow2_arena m_arena;
+	free_node* m_free[class_count];
+};
+
+class size_class_cache
+{
+public:
+	static constexpr std::size_t cache_depth = 32;
+	static constexpr std::size_t batch_size = cache_depth / 2;
+
+	explicit size_class_cache(size_class_pool& pool) noexcept : m_pool(pool)
+	{
+		for (std::size_t& count : m_counts)
+			count = 0;
+	}
+
+	size_class_cache(const size_class_cache&) = delete;
+	size_class_cache& operator=(const size_class_cache&) = delete;
+
+	~size_class_cache()
+	{
+		flush();
+	}
+
+	void* allocate(const std::size_t size)
+	{
+		const int size_class = size_class_pool::size_class(size);
+
+		if (size_class > size_class_pool::max_class)
+			return ::operator new(size);
+
+		const int index = size_class - size_class_pool::min_class;
+
+		if (m_counts[index] == 0)
+		{
+			m_pool.take(size_class, m_chunks[index], batch_size);
+			m_counts[index] = batch_size;
+		}
+
+		return m_chunks[index][--m_counts[index]];
+	}
+
+	void deallocate(void* const ptr, const std::size_t size) noexcept
+	{
+		const int size_class = size_class_pool::size_class(size);
+
+		if (size_class > size_class_pool::max_class)
+		{
+			::operator delete(ptr);
+			return;
+		}
+
+		const int index = size_class - size_class_pool::min_class;
+
+		if (m_counts[index] == cache_depth)
+		{
+			m_counts[index] -= batch_size;
+			m_pool.give(size_class, m_chunks[index] + m_counts[index], batch_size);
+		}
+
+		m_chunks[index][m_counts[index]++] = ptr;
+	}
+
+	void flush() noexcept
+	{
+		for (int index = 0; index < size_class_pool::class_count; ++index)
+		{
+			m_pool.give(index + size_class_pool::min_class, m_chunks[index], m_counts[index]);
+			m_counts[index] = 0;
+		}
+	}
+
+private:
+	size_class_pool& m_pool;
+	std::size_t m_counts[size_class_pool::class_count];
+	void* m_chunks[size_class_pool::class_count][cache_depth];
+};
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
@@ -55,4 +55,34 @@ defined(_M_IX86) || defined(__LP64__) ||defined(_M_AMD64) || defined(_M_X64) ||\
 #if defined(_WIN64) || defined(__x86_64) || defined(__x86_64__) || defined(__LP64__ ) ||\
  defined(__LP64) || defined(_M_X64) || defined(_M_ARM64)
 #define BIT14_USING_64BIT
+#endif
+
+#if defined(BIT14_USING_X86)
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BIT14_USING_SSE2
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX__)
+#define BIT14_USING_SSSE3
+#endif
+
+#if defined(__SSE4_1__) || defined(__AVX__)
+#define BIT14_USING_SSE4_1
+#endif
+
+#ifdef __AVX2__
+#define BIT14_USING_AVX2
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#define BIT14_USING_AVX512
+#endif
+
+#if defined(__BMI2__) || (defined(BIT14_USING_MSVC) && defined(__AVX2__))
+#define BIT14_USING_BMI2
+#endif
+#endif
+
+#if defined(BIT14_USING_ARM) && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+#define BIT14_USING_NEON
 #endif
\ No newline at end of file
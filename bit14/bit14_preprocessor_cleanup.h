@@ -35,4 +35,11 @@
 #undef BIT14_USING_OPENXL
 #undef BIT14_USING_X86
 #undef BIT14_USING_64BIT
-#undef BIT14_USING_ARM
\ No newline at end of file
+#undef BIT14_USING_ARM
+#undef BIT14_USING_SSE2
+#undef BIT14_USING_SSSE3
+#undef BIT14_USING_SSE4_1
+#undef BIT14_USING_AVX2
+#undef BIT14_USING_AVX512
+#undef BIT14_USING_BMI2
+#undef BIT14_USING_NEON
\ No newline at end of file
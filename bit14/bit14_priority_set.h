@@ -0,0 +1,296 @@
+//bit14_priority_set.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	bit14::bit_priority_set<N> is a set of integers in [0, N) stored as
+|||	a tree of 64 bit words. Level 0 holds one bit per element and every
+|||	level above holds one bit per non-empty word of the level below,
+|||	up to a single root word. 4096 elements need 2 levels, 262144 need 3.
+|||
+|||	Every operation below touches one word per level and finds bits
+|||	with bit14::countr_zero / bit14::countl_zero, so the cost is a
+|||	compile time constant independent of how many elements are stored:
+|||
+|||		bool insert(std::size_t x) noexcept;		//true when x was not present
+|||		bool erase(std::size_t x) noexcept;		//true when x was present
+|||		bool contains(std::size_t x) const noexcept;
+|||		bool empty() const noexcept;
+|||		void clear() noexcept;
+|||		std::size_t count() const noexcept;		//popcount over level 0
+|||		std::size_t min() const noexcept;
+|||		std::size_t max() const noexcept;
+|||		std::size_t lower_bound(std::size_t x) const noexcept;		//smallest >= x
+|||		std::size_t successor(std::size_t x) const noexcept;		//smallest > x
+|||		std::size_t predecessor(std::size_t x) const noexcept;	//largest < x
+|||
+|||	Lookups return bit_priority_set<N>::npos when no element qualifies.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+namespace detail
+{
+constexpr std::size_t summary_words(const std::size_t bits) noexcept
+{
+	return (bits + 63) / 64;
+}
+
+constexpr std::size_t summary_levels(const std::size_t bits) noexcept
+{
+	return bits <= 64 ? 1 : 1 + summary_levels(summary_words(bits));
+}
+
+template <std::size_t Levels>
+struct summary_layout
+{
+	std::size_t offsets[Levels + 1];
+};
+
+//offsets[level] is the first word of level, offsets[Levels] the total word count.
+template <std::size_t Levels>
+constexpr summary_layout<Levels> make_summary_layout(std::size_t bits) noexcept
+{
+	summary_layout<Levels> layout{};
+	std::size_t offset = 0;
+
+	for (std::size_t level = 0; level <= Levels; ++level)
+	{
+		layout.offsets[level] = offset;
+		bits = summary_words(bits);
+		offset += bits;
+	}
+
+	return layout;
+}
+} //end namespace detail
+
+template <std::size_t N>
+class bit_priority_set
+{
+	static_assert(N > 0, "bit14::bit_priority_set requires at least one element.\n");
+
+public:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+	static constexpr std::size_t levels = detail::summary_levels(N);
+
+	bit_priority_set() noexcept
+	{
+		clear();
+	}
+
+	void clear() noexcept
+	{
+		for (std::size_t i = 0; i < total_words; ++i)
+			m_words[i] = 0;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_words[offset(levels - 1)] == 0;
+	}
+
+	bool contains(const std::size_t x) const noexcept
+	{
+		return (m_words[x / 64] >> (x % 64)) & 1;
+	}
+
+	std::size_t count() const noexcept
+	{
+		std::size_t result = 0;
+
+		for (std::size_t i = 0; i < detail::summary_words(N); ++i)
+			result += static_cast<std::size_t>(bit14::popcount(m_words[i]));
+
+		return result;
+	}
+
+	bool insert(std::size_t x) noexcept
+	{
+		uint64_t bit = uint64_t{ 1 } << (x % 64);
+		uint64_t* word = &m_words[x / 64];
+
+		if (*word & bit)
+			return false;
+
+		for (std::size_t level = 0; level < levels; ++level)
+		{
+			const bool was_empty = (*word == 0);
+			*word |= bit;
+
+			if (!was_empty || level + 1 == levels)
+				break;
+
+			x /= 64;
+			bit = uint64_t{ 1 } << (x % 64);
+			word = &m_words[offset(level + 1) + x / 64];
+		}
+
+		return true;
+	}
+
+	bool erase(std::size_t x) noexcept
+	{
+		uint64_t bit = uint64_t{ 1 } << (x % 64);
+		uint64_t* word = &m_words[x / 64];
+
+		if (!(*word & bit))
+			return false;
+
+		for (std::size_t level = 0; level < levels; ++level)
+		{
+			*word &= ~bit;
+
+			if (*word != 0 || level + 1 == levels)
+				break;
+
+			x /= 64;
+			bit = uint64_t{ 1 } << (x % 64);
+			word = &m_words[offset(level + 1) + x / 64];
+		}
+
+		return true;
+	}
+
+	std::size_t min() const noexcept
+	{
+		if (empty())
+			return npos;
+
+		return descend_min(levels - 1, bit14::countr_zero(m_words[offset(levels - 1)]));
+	}
+
+	std::size_t max() const noexcept
+	{
+		if (empty())
+			return npos;
+
+		return descend_max(levels - 1, 63 - bit14::countl_zero(m_words[offset(levels - 1)]));
+	}
+
+	std::size_t lower_bound(std::size_t x) const noexcept
+	{
+		if (x >= N)
+			return npos;
+
+		for (std::size_t level = 0; level < levels; ++level)
+		{
+			const std::size_t word_index = x / 64;
+			const uint64_t word = m_words[offset(level) + word_index] & (~uint64_t{ 0 } << (x % 64));
+
+			if (word)
+				return descend_min(level, word_index * 64 + bit14::countr_zero(word));
+
+			x = word_index + 1;
+
+			if (x >= layout.offsets[level + 1] - layout.offsets[level])
+				return npos;
+		}
+
+		return npos;
+	}
+
+	std::size_t successor(const std::size_t x) const noexcept
+	{
+		return x + 1 < N ? lower_bound(x + 1) : npos;
+	}
+
+	std::size_t predecessor(std::size_t x) const noexcept
+	{
+		if (x == 0)
+			return npos;
+
+		x = (x > N ? N : x) - 1;
+
+		for (std::size_t level = 0; level < levels; ++level)
+		{
+			const std::size_t word_index = x / 64;
+			const uint64_t word = m_words[offset(level) + word_index] & (~uint64_t{ 0 } >> (63 - x % 64));
+
+			if (word)
+				return descend_max(level, word_index * 64 + 63 - bit14::countl_zero(word));
+
+			if (word_index == 0)
+				return npos;
+
+			x = word_index - 1;
+		}
+
+		return npos;
+	}
+
+private:
+	static constexpr detail::summary_layout<levels> layout = detail::make_summary_layout<levels>(N);
+	static constexpr std::size_t total_words = layout.offsets[levels];
+
+	static std::size_t offset(const std::size_t level) noexcept
+	{
+		return layout.offsets[level];
+	}
+
+	//index is a set bit at level, the result is the smallest element below it.
+	std::size_t descend_min(std::size_t level, std::size_t index) const noexcept
+	{
+		while (level-- > 0)
+			index = index * 64 + bit14::countr_zero(m_words[offset(level) + index]);
+
+		return index;
+	}
+
+	std::size_t descend_max(std::size_t level, std::size_t index) const noexcept
+	{
+		while (level-- > 0)
+			index = index * 64 + 63 - bit14::countl_zero(m_words[offset(level) + index]);
+
+		return index;
+	}
+
+	uint64_t m_words[total_words];
+};
+
+template <std::size_t N>
+constexpr std::size_t bit_priority_set<N>::npos;
+
+template <std::size_t N>
+constexpr std::size_t bit_priority_set<N>::levels;
+
+template <std::size_t N>
+constexpr detail::summary_layout<bit_priority_set<N>::levels> bit_priority_set<N>::layout;
+
+template <std::size_t N>
+constexpr std::size_t bit_priority_set<N>::total_words;
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
@@ -0,0 +1,541 @@
+//bit14_quotient_filter.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	bit14::quotient_filter<R> is a rank and select quotient filter
+|||	(RSQF) over uint64_t keys. Unlike a Bloom filter it supports erase
+|||	and merging. A key is mixed to a 64 bit fingerprint: the low
+|||	8 * sizeof(R) bits are its remainder (R is uint8_t, uint16_t or
+|||	uint32_t), the next quotient_bits bits its home slot.
+|||
+|||		explicit quotient_filter(int quotient_bits);
+|||		bool insert(uint64_t key) noexcept;		//false when the filter is full
+|||		bool erase(uint64_t key) noexcept;		//false when no fingerprint matched
+|||		bool contains(uint64_t key) const noexcept;
+|||		bool merge(const quotient_filter& a, const quotient_filter& b) noexcept;
+|||		void clear() noexcept;
+|||		std::size_t size() const noexcept;
+|||		std::size_t slot_count() const noexcept;		//2^quotient_bits
+|||		double load_factor() const noexcept;
+|||		std::size_t size_in_bytes() const noexcept;
+|||
+|||	Slots are grouped in blocks of 64, each holding an occupieds word
+|||	(bit x: some fingerprint has quotient x), a runends word (bit y:
+|||	slot y ends the run of one quotient), the remainders and an offset:
+|||	how many of the block's slots are taken by runs of quotients from
+|||	earlier blocks. Remainders are sorted inside a run. The end of the
+|||	run of quotient x is found with one popcount rank of the occupieds
+|||	up to x and a select over the runends after the offset, using
+|||	detail::select_in_word (pdep with BMI2, broadword otherwise).
+|||
+|||	insert() shifts the slots up to the next empty one and erase()
+|||	shifts back up to the next empty slot or run at its home slot.
+|||	Neither allocates. About 10 * sqrt(2^quotient_bits) spare slots
+|||	after the last quotient absorb runs that spill past the end. Equal
+|||	fingerprints are kept as a multiset, erase() drops one of them.
+|||
+|||	merge() rebuilds this filter from a and b, which must be other
+|||	filters with the same quotient_bits. It walks both in fingerprint
+|||	order and appends to this filter, so it runs in linear time. It
+|||	returns false, leaving this filter empty, if the two filters do
+|||	not fit together.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <cstring>			//memmove
+#include <cmath>			//sqrt
+#include <type_traits>		//is_unsigned
+#include <vector>			//vector
+#include "bit14.h"
+#include "bit14_elias_fano.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+namespace detail
+{
+inline uint64_t quotient_mix(uint64_t key) noexcept
+{
+	key ^= key >> 30;
+	key *= 0xBF58476D1CE4E5B9ull;
+	key ^= key >> 27;
+	key *= 0x94D049BB133111EBull;
+	key ^= key >> 31;
+	return key;
+}
+
+template <typename R>
+struct quotient_filter_block
+{
+	uint64_t occupieds;
+	uint64_t runends;
+	uint32_t offset;
+	R remainders[64];
+};
+
+//Bits lo to hi of a word.
+inline uint64_t bit_range(const int lo, const int hi) noexcept
+{
+	return (~uint64_t{ 0 } >> (63 - hi)) & (~uint64_t{ 0 } << lo);
+}
+} //end namespace detail
+
+template <typename R = uint16_t>
+class quotient_filter
+{
+	static_assert(std::is_unsigned<R>::value && sizeof(R) <= 4,
+		"bit14::quotient_filter requires an unsigned remainder type of at most 32 bits.\n");
+
+public:
+	static constexpr int remainder_bits = 8 * sizeof(R);
+
+	explicit quotient_filter(const int quotient_bits)
+		: m_quotient_bits(quotient_bits), m_slots(std::size_t{ 1 } << quotient_bits), m_size(0),
+		m_blocks(block_count_for(m_slots))
+	{
+		assert(quotient_bits >= 0 && quotient_bits + remainder_bits <= 64);
+	}
+
+	std::size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	std::size_t slot_count() const noexcept
+	{
+		return m_slots;
+	}
+
+	double load_factor() const noexcept
+	{
+		return static_cast<double>(m_size) / static_cast<double>(m_slots);
+	}
+
+	std::size_t size_in_bytes() const noexcept
+	{
+		return m_blocks.size() * sizeof(block);
+	}
+
+	void clear() noexcept
+	{
+		for (block& b : m_blocks)
+			b = block{};
+
+		m_size = 0;
+	}
+
+	bool contains(const uint64_t key) const noexcept
+	{
+		std::size_t quotient;
+		R remainder;
+		fingerprint(key, quotient, remainder);
+
+		if (!occupied(quotient))
+			return false;
+
+		//Walk the run backwards from its end, remainders are sorted.
+		for (std::size_t y = run_limit(quotient) - 1;; --y)
+		{
+			const R value = remainder_at(y);
+
+			if (value == remainder)
+				return true;
+
+			if (value < remainder || y == quotient || runend(y - 1))
+				return false;
+		}
+	}
+
+	bool insert(const uint64_t key) noexcept
+	{
+		std::size_t quotient;
+		R remainder;
+		fingerprint(key, quotient, remainder);
+
+		const std::size_t limit = run_limit(quotient);
+		const bool existing = occupied(quotient);
+		std::size_t position = (limit > quotient) ? limit : quotient;
+
+		if (existing)
+		{
+			position = run_start(quotient);
+
+			while (position < limit && remainder_at(position) <= remainder)
+				++position;
+		}
+
+		const std::size_t empty = find_empty(position);
+
+		if (empty == npos)
+			return false;
+
+		shift_up(position, empty);
+		m_blocks[position / 64].remainders[position % 64] = remainder;
+
+		if (!existing)
+		{
+			set_runend(position);
+			m_blocks[quotient / 64].occupieds |= uint64_t{ 1 } << (quotient % 64);
+		}
+		else if (position == limit)
+		{
+			clear_runend(limit - 1);
+			set_runend(position);
+		}
+
+		//Every block starting in (quotient, empty] now has one more slot taken by earlier quotients.
+		for (std::size_t b = quotient / 64 + 1; b * 64 <= empty; ++b)
+			++m_blocks[b].offset;
+
+		++m_size;
+		return true;
+	}
+
+	bool erase(const uint64_t key) noexcept
+	{
+		std::size_t quotient;
+		R remainder;
+		fingerprint(key, quotient, remainder);
+
+		if (!occupied(quotient))
+			return false;
+
+		const std::size_t start = run_start(quotient);
+		const std::size_t limit = run_limit(quotient);
+		std::size_t position = limit - 1;
+
+		while (remainder_at(position) != remainder)
+		{
+			if (remainder_at(position) < remainder || position == start)
+				return false;
+
+			--position;
+		}
+
+		const std::size_t stop = find_stop(quotient, limit);
+
+		if (start == limit - 1)
+			m_blocks[quotient / 64].occupieds &= ~(uint64_t{ 1 } << (quotient % 64));
+		else if (position == limit - 1)
+			set_runend(position - 1);
+
+		shift_down(position, stop - 1);
+
+		for (std::size_t b = quotient / 64 + 1; b * 64 < stop; ++b)
+			--m_blocks[b].offset;
+
+		--m_size;
+		return true;
+	}
+
+	bool merge(const quotient_filter& a, const quotient_filter& b) noexcept
+	{
+		clear();
+
+		if (a.m_quotient_bits != m_quotient_bits || b.m_quotient_bits != m_quotient_bits)
+			return false;
+
+		cursor left(a);
+		cursor right(b);
+		std::size_t quotient = npos;
+		std::size_t next = 0;
+
+		while (left.valid() || right.valid())
+		{
+			const bool take_left = !right.valid() || (left.valid() && (left.quotient < right.quotient ||
+				(left.quotient == right.quotient && left.remainder() <= right.remainder())));
+			cursor& source = take_left ? left : right;
+
+			if (source.quotient != quotient)
+			{
+				if (quotient != npos)
+					close_run(quotient, next - 1);
+
+				quotient = source.quotient;
+				m_blocks[quotient / 64].occupieds |= uint64_t{ 1 } << (quotient % 64);
+				next = (next > quotient) ? next : quotient;
+			}
+
+			if (next >= m_blocks.size() * 64)
+			{
+				clear();
+				return false;
+			}
+
+			m_blocks[next / 64].remainders[next % 64] = source.remainder();
+			++next;
+			++m_size;
+			source.advance();
+		}
+
+		if (quotient != npos)
+			close_run(quotient, next - 1);
+
+		return true;
+	}
+
+private:
+	using block = detail::quotient_filter_block<R>;
+
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	//Walks the fingerprints of a filter in (quotient, remainder) order.
+	struct cursor
+	{
+		explicit cursor(const quotient_filter& source) noexcept
+			: filter(source), quotient(source.next_occupied(0)), position(quotient)
+		{
+		}
+
+		bool valid() const noexcept
+		{
+			return quotient != npos;
+		}
+
+		R remainder() const noexcept
+		{
+			return filter.remainder_at(position);
+		}
+
+		void advance() noexcept
+		{
+			if (!filter.runend(position))
+			{
+				++position;
+				return;
+			}
+
+			quotient = filter.next_occupied(quotient + 1);
+			position = (position + 1 > quotient) ? position + 1 : quotient;
+		}
+
+		const quotient_filter& filter;
+		std::size_t quotient;
+		std::size_t position;
+	};
+
+	static std::size_t block_count_for(const std::size_t slots) noexcept
+	{
+		const std::size_t spare = static_cast<std::size_t>(10 * std::sqrt(static_cast<double>(slots)));
+		return (slots + spare + 63) / 64 + 1;
+	}
+
+	void fingerprint(const uint64_t key, std::size_t& quotient, R& remainder) const noexcept
+	{
+		const uint64_t hash = detail::quotient_mix(key);
+		quotient = static_cast<std::size_t>(hash >> remainder_bits) & (m_slots - 1);
+		remainder = static_cast<R>(hash);
+	}
+
+	bool occupied(const std::size_t x) const noexcept
+	{
+		return (m_blocks[x / 64].occupieds >> (x % 64)) & 1;
+	}
+
+	bool runend(const std::size_t y) const noexcept
+	{
+		return (m_blocks[y / 64].runends >> (y % 64)) & 1;
+	}
+
+	void set_runend(const std::size_t y) noexcept
+	{
+		m_blocks[y / 64].runends |= uint64_t{ 1 } << (y % 64);
+	}
+
+	void clear_runend(const std::size_t y) noexcept
+	{
+		m_blocks[y / 64].runends &= ~(uint64_t{ 1 } << (y % 64));
+	}
+
+	R remainder_at(const std::size_t y) const noexcept
+	{
+		return m_blocks[y / 64].remainders[y % 64];
+	}
+
+	//Position of the rank-th (1 based) run end at or after slot from.
+	std::size_t select_runend(const std::size_t from, std::size_t rank) const noexcept
+	{
+		std::size_t b = from / 64;
+		uint64_t word = m_blocks[b].runends & (~uint64_t{ 0 } << (from % 64));
+
+		for (;;)
+		{
+			const std::size_t ones = static_cast<std::size_t>(bit14::popcount(word));
+
+			if (rank <= ones)
+				return b * 64 + static_cast<std::size_t>(detail::select_in_word(word, static_cast<int>(rank - 1)));
+
+			rank -= ones;
+			word = m_blocks[++b].runends;
+		}
+	}
+
+	//One past the last slot used by the runs of quotients up to x, at most x when slot x is empty.
+	std::size_t run_limit(const std::size_t x) const noexcept
+	{
+		const block& b = m_blocks[x / 64];
+		const std::size_t first = (x & ~std::size_t{ 63 }) + b.offset;
+		const uint64_t below = b.occupieds & (~uint64_t{ 0 } >> (63 - x % 64));
+
+		if (below == 0)
+			return first;
+
+		return select_runend(first, static_cast<std::size_t>(bit14::popcount(below))) + 1;
+	}
+
+	std::size_t run_start(const std::size_t quotient) const noexcept
+	{
+		const std::size_t previous = (quotient == 0) ? 0 : run_limit(quotient - 1);
+		return (previous > quotient) ? previous : quotient;
+	}
+
+	std::size_t next_occupied(std::size_t x) const noexcept
+	{
+		while (x < m_slots)
+		{
+			const uint64_t word = m_blocks[x / 64].occupieds & (~uint64_t{ 0 } << (x % 64));
+
+			if (word)
+				return (x & ~std::size_t{ 63 }) + static_cast<std::size_t>(bit14::countr_zero(word));
+
+			x = (x | 63) + 1;
+		}
+
+		return npos;
+	}
+
+	std::size_t find_empty(std::size_t y) const noexcept
+	{
+		const std::size_t slots = m_blocks.size() * 64;
+
+		while (y < slots)
+		{
+			const std::size_t limit = run_limit(y);
+
+			if (limit <= y)
+				return y;
+
+			y = limit;
+		}
+
+		return npos;
+	}
+
+	//First slot after the run of quotient that is empty or starts a run at its home slot.
+	std::size_t find_stop(std::size_t quotient, std::size_t limit) const noexcept
+	{
+		for (;;)
+		{
+			quotient = next_occupied(quotient + 1);
+
+			if (quotient == npos || quotient >= limit)
+				return limit;
+
+			limit = select_runend(limit, 1) + 1;
+		}
+	}
+
+	//Moves slots [from, to) up by one, slot from keeps its remainder and loses its run end.
+	void shift_up(const std::size_t from, const std::size_t to) noexcept
+	{
+		const std::size_t first = from / 64;
+
+		for (std::size_t b = to / 64 + 1; b-- > first;)
+		{
+			block& current = m_blocks[b];
+			const int lo = (b == first) ? static_cast<int>(from % 64) : 0;
+			const int hi = (b == to / 64) ? static_cast<int>(to % 64) : 63;
+			uint64_t moved = (current.runends << 1) & detail::bit_range(lo, hi) & ~(uint64_t{ 1 } << lo);
+
+			std::memmove(&current.remainders[lo + 1], &current.remainders[lo], static_cast<std::size_t>(hi - lo) * sizeof(R));
+
+			if (b > first)
+			{
+				current.remainders[0] = m_blocks[b - 1].remainders[63];
+				moved |= m_blocks[b - 1].runends >> 63;
+			}
+
+			current.runends = (current.runends & ~detail::bit_range(lo, hi)) | moved;
+		}
+	}
+
+	//Moves slots (from, to] down by one and empties slot to.
+	void shift_down(const std::size_t from, const std::size_t to) noexcept
+	{
+		const std::size_t last = to / 64;
+
+		for (std::size_t b = from / 64; b <= last; ++b)
+		{
+			block& current = m_blocks[b];
+			const int lo = (b == from / 64) ? static_cast<int>(from % 64) : 0;
+			const int hi = (b == last) ? static_cast<int>(to % 64) : 63;
+			uint64_t moved = (current.runends >> 1) & detail::bit_range(lo, hi) & ~(uint64_t{ 1 } << hi);
+
+			std::memmove(&current.remainders[lo], &current.remainders[lo + 1], static_cast<std::size_t>(hi - lo) * sizeof(R));
+
+			if (b < last)
+			{
+				current.remainders[63] = m_blocks[b + 1].remainders[0];
+				moved |= m_blocks[b + 1].runends << 63;
+			}
+			else
+			{
+				current.remainders[hi] = 0;
+			}
+
+			current.runends = (current.runends & ~detail::bit_range(lo, hi)) | moved;
+		}
+	}
+
+	//Marks the end of a run appended by merge() and the blocks it spills into.
+	void close_run(const std::size_t quotient, const std::size_t end) noexcept
+	{
+		set_runend(end);
+
+		for (std::size_t b = quotient / 64 + 1; b * 64 <= end; ++b)
+			m_blocks[b].offset = static_cast<uint32_t>(end - b * 64 + 1);
+	}
+
+	int m_quotient_bits;
+	std::size_t m_slots;
+	std::size_t m_size;
+	std::vector<block> m_blocks;
+};
+
+template <typename R>
+constexpr int quotient_filter<R>::remainder_bits;
+
+template <typename R>
+constexpr std::size_t quotient_filter<R>::npos;
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
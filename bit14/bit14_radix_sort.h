@@ -0,0 +1,300 @@
+//bit14_radix_sort.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	Least significant digit first radix sort for arithmetic keys.
+|||
+|||		template <typename T>
+|||		void radix_sort(T* keys, std::size_t n, unsigned threads = 1);
+|||		template <typename T, typename V>
+|||		void radix_sort(T* keys, V* values, std::size_t n, unsigned threads = 1);
+|||		template <typename T>
+|||		void radix_sort_big_endian(T* keys, std::size_t n, unsigned threads = 1);
+|||
+|||	Every key is mapped to an unsigned integer of the same size whose
+|||	order matches the order of the keys: signed integers flip their sign
+|||	bit, floats and doubles go through bit14::bit_cast and flip the sign
+|||	bit of positive values or all bits of negative ones. NaNs sort by
+|||	their bit pattern, negative ones first and positive ones last.
+|||	radix_sort_big_endian() sorts unsigned integers holding big endian
+|||	serialized values, comparing them after bit14::byteswap on little
+|||	endian platforms.
+|||
+|||	Keys of 1 or 2 bytes use 8 bit digits, wider keys 11 bit digits so a
+|||	32 bit key takes 3 passes. The histograms of all passes are counted
+|||	in one sweep over the input and passes whose digit is the same for
+|||	every key are skipped. The sort is stable and needs a scratch copy
+|||	of the keys and values.
+|||
+|||	With threads > 1 (0 picks std::thread::hardware_concurrency) each
+|||	thread counts and scatters its own slice of the input, inputs too
+|||	small to share run on one thread.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <vector>			//vector
+#include <thread>			//thread
+#include <utility>			//move, swap
+#include <algorithm>		//copy, fill, min
+#include <type_traits>		//is_floating_point, is_signed, make_unsigned, conditional
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+namespace detail
+{
+template <typename T, bool = std::is_floating_point<T>::value, bool = std::is_signed<T>::value>
+struct radix_key
+{
+	using type = typename std::make_unsigned<T>::type;
+
+	static type get(const T value) noexcept
+	{
+		return static_cast<type>(value);
+	}
+};
+
+template <typename T>
+struct radix_key<T, false, true>
+{
+	using type = typename std::make_unsigned<T>::type;
+
+	static type get(const T value) noexcept
+	{
+		constexpr type sign = type{ 1 } << (numeric_limits<type>::digits - 1);
+		return static_cast<type>(static_cast<type>(value) ^ sign);
+	}
+};
+
+template <typename T, bool Signed>
+struct radix_key<T, true, Signed>
+{
+	static_assert(sizeof(T) == 4 || sizeof(T) == 8,
+		"bit14::radix_sort requires 4 or 8 byte floating point keys.\n");
+
+	using type = typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type;
+
+	static type get(const T value) noexcept
+	{
+		constexpr type sign = type{ 1 } << (numeric_limits<type>::digits - 1);
+		const type bits = bit14::bit_cast<type>(value);
+		return (bits & sign) ? static_cast<type>(~bits) : static_cast<type>(bits | sign);
+	}
+};
+
+template <typename T>
+struct radix_big_endian_key
+{
+	using type = T;
+
+	static type get(const T value) noexcept
+	{
+		return (endian::native == endian::little) ? bit14::byteswap(value) : value;
+	}
+};
+
+struct radix_no_values {};
+
+inline void radix_move_value(radix_no_values*, std::size_t, radix_no_values*, std::size_t) noexcept {}
+
+template <typename V>
+void radix_move_value(V* const dst, const std::size_t to, V* const src, const std::size_t from)
+{
+	dst[to] = std::move(src[from]);
+}
+
+inline std::size_t radix_value_scratch(radix_no_values*, std::size_t) noexcept
+{
+	return 0;
+}
+
+template <typename V>
+std::size_t radix_value_scratch(V*, const std::size_t n) noexcept
+{
+	return n;
+}
+
+//Runs f(thread, first, last) over equal slices of [0, n), slice 0 on the calling thread.
+template <typename F>
+void radix_for_slices(const unsigned threads, const std::size_t n, F f)
+{
+	std::vector<std::thread> workers;
+	workers.reserve(threads - 1);
+
+	for (unsigned t = 1; t < threads; ++t)
+		workers.emplace_back(f, t, n * t / threads, n * (t + 1) / threads);
+
+	f(0u, std::size_t{ 0 }, n / threads);
+
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+template <typename Key, int DigitBits, typename T, typename V>
+void radix_sort_impl(T* const keys, V* const values, const std::size_t n, unsigned threads)
+{
+	using U = typename Key::type;
+	constexpr int passes = (numeric_limits<U>::digits + DigitBits - 1) / DigitBits;
+	constexpr std::size_t radix = std::size_t{ 1 } << DigitBits;
+	constexpr std::size_t min_slice = std::size_t{ 1 } << 16;
+
+	const auto digit = [](const T& value, const int pass) noexcept
+	{
+		return static_cast<std::size_t>(Key::get(value) >> (pass * DigitBits)) & (radix - 1);
+	};
+
+	if (n < 2)
+		return;
+
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+
+	threads = static_cast<unsigned>(std::min<std::size_t>(threads == 0 ? 1 : threads, (n + min_slice - 1) / min_slice));
+
+	//One histogram per thread and pass, counted in a single sweep.
+	std::vector<std::size_t> counts(std::size_t{ threads } * passes * radix, 0);
+	radix_for_slices(threads, n, [&](const unsigned t, const std::size_t first, const std::size_t last)
+	{
+		std::size_t* const histogram = &counts[std::size_t{ t } * passes * radix];
+
+		for (std::size_t i = first; i < last; ++i)
+		{
+			for (int pass = 0; pass < passes; ++pass)
+				++histogram[pass * radix + digit(keys[i], pass)];
+		}
+	});
+
+	std::vector<T> key_scratch(n);
+	std::vector<V> value_scratch(radix_value_scratch(values, n));
+	std::vector<std::size_t> offsets(std::size_t{ threads } * radix);
+	T* source_keys = keys;
+	T* target_keys = key_scratch.data();
+	V* source_values = values;
+	V* target_values = value_scratch.data();
+	bool scattered = false;
+
+	for (int pass = 0; pass < passes; ++pass)
+	{
+		//Slices hold different keys after the first pass, so their histograms are counted again.
+		if (threads > 1 && scattered)
+		{
+			std::fill(counts.begin(), counts.end(), 0);
+			radix_for_slices(threads, n, [&](const unsigned t, const std::size_t first, const std::size_t last)
+			{
+				std::size_t* const histogram = &counts[(std::size_t{ t } * passes + pass) * radix];
+
+				for (std::size_t i = first; i < last; ++i)
+					++histogram[digit(source_keys[i], pass)];
+			});
+		}
+
+		std::size_t total = 0;
+		bool constant = false;
+
+		for (std::size_t d = 0; d < radix; ++d)
+		{
+			std::size_t in_digit = 0;
+
+			for (unsigned t = 0; t < threads; ++t)
+			{
+				const std::size_t count = counts[(std::size_t{ t } * passes + pass) * radix + d];
+				offsets[std::size_t{ t } * radix + d] = total + in_digit;
+				in_digit += count;
+			}
+
+			constant = constant || (in_digit == n);
+			total += in_digit;
+		}
+
+		if (constant)
+			continue;
+
+		radix_for_slices(threads, n, [&](const unsigned t, const std::size_t first, const std::size_t last)
+		{
+			std::size_t* const offset = &offsets[std::size_t{ t } * radix];
+
+			for (std::size_t i = first; i < last; ++i)
+			{
+				const std::size_t to = offset[digit(source_keys[i], pass)]++;
+				target_keys[to] = source_keys[i];
+				radix_move_value(target_values, to, source_values, i);
+			}
+		});
+
+		std::swap(source_keys, target_keys);
+		std::swap(source_values, target_values);
+		scattered = true;
+	}
+
+	if (source_keys != keys)
+	{
+		std::copy(source_keys, source_keys + n, keys);
+
+		for (std::size_t i = 0; i < n; ++i)
+			radix_move_value(values, i, source_values, i);
+	}
+}
+
+template <typename Key>
+struct radix_digit_bits : std::integral_constant<int, (sizeof(typename Key::type) <= 2) ? 8 : 11> {};
+} //end namespace detail
+
+template <typename T>
+void radix_sort(T* const keys, const std::size_t n, const unsigned threads = 1)
+{
+	static_assert(std::is_arithmetic<T>::value, "bit14::radix_sort requires arithmetic keys.\n");
+	using key = detail::radix_key<T>;
+	detail::radix_sort_impl<key, detail::radix_digit_bits<key>::value>(
+		keys, static_cast<detail::radix_no_values*>(nullptr), n, threads);
+}
+
+template <typename T, typename V>
+void radix_sort(T* const keys, V* const values, const std::size_t n, const unsigned threads = 1)
+{
+	static_assert(std::is_arithmetic<T>::value, "bit14::radix_sort requires arithmetic keys.\n");
+	using key = detail::radix_key<T>;
+	detail::radix_sort_impl<key, detail::radix_digit_bits<key>::value>(keys, values, n, threads);
+}
+
+template <typename T>
+void radix_sort_big_endian(T* const keys, const std::size_t n, const unsigned threads = 1)
+{
+	static_assert(detail::is_bit14_type<T>::value,
+		"bit14::radix_sort_big_endian requires unsigned integer keys.\n");
+	using key = detail::radix_big_endian_key<T>;
+	detail::radix_sort_impl<key, detail::radix_digit_bits<key>::value>(
+		keys, static_cast<detail::radix_no_values*>(nullptr), n, threads);
+}
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
@@ -0,0 +1,813 @@
+//bit14_roaring.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	bit14::roaring is a compressed set of 32 bit integers in the style
+|||	of Roaring bitmaps. Values are grouped by their high 16 bits into
+|||	chunks of 65536 and every chunk is stored in the container that
+|||	suits its density:
+|||
+|||		array	sorted 16 bit values, up to 4096 of them
+|||		bitmap	1024 64 bit words, for more than 4096 values
+|||		run		sorted [start, start + length] pairs of 16 bit values
+|||
+|||	Arrays and bitmaps convert into each other as the cardinality of a
+|||	chunk crosses 4096. Run containers are only created by
+|||	run_optimize(), which picks them for chunks where they are the
+|||	smallest form, and a run container that is modified turns back into
+|||	an array or bitmap first.
+|||
+|||		bool add(uint32_t value);			//true when value was not present
+|||		bool remove(uint32_t value);		//true when value was present
+|||		bool contains(uint32_t value) const noexcept;
+|||		uint64_t cardinality() const noexcept;
+|||		bool empty() const noexcept;
+|||		void clear() noexcept;
+|||		void run_optimize();
+|||		template <typename F>
+|||		void for_each(F&& f) const;			//calls f(uint32_t) in increasing order
+|||		roaring& operator|=(const roaring& other);
+|||		roaring& operator&=(const roaring& other);
+|||		friend roaring operator|(roaring a, const roaring& b);
+|||		friend roaring operator&(roaring a, const roaring& b);
+|||		void swap(roaring& other) noexcept;
+|||		std::vector<unsigned char> serialize() const;
+|||		bool deserialize(const unsigned char* data, std::size_t size);
+|||
+|||	Bitmap against bitmap operations run fused word kernels that count
+|||	the result with bit14::popcount in the same pass, iteration walks
+|||	bitmap words with bit14::countr_zero.
+|||
+|||	The serialized form is little endian on every platform:
+|||
+|||		uint32_t container count
+|||		per container: uint16_t key, uint8_t kind (0 array, 1 bitmap,
+|||		2 run), uint32_t cardinality, uint32_t run count, followed by
+|||		cardinality uint16_t values, 1024 uint64_t words or 2 * run
+|||		count uint16_t values
+|||
+|||	deserialize() validates its input and returns false, leaving the set
+|||	empty, when the data is malformed.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <vector>			//vector
+#include <algorithm>		//lower_bound, set_intersection, set_union
+#include <iterator>			//back_inserter
+#include <utility>			//move, swap
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+namespace detail
+{
+enum class roaring_kind : unsigned char
+{
+	array = 0,
+	bitmap = 1,
+	run = 2
+};
+
+constexpr uint32_t roaring_array_max = 4096;
+constexpr std::size_t roaring_bitmap_words = 1024;
+
+struct roaring_container
+{
+	roaring_kind kind;
+	uint32_t cardinality;
+	std::vector<uint16_t> values;	//array: sorted values, run: start and length pairs
+	std::vector<uint64_t> words;	//bitmap
+};
+
+inline uint32_t bitmap_or(uint64_t* const dst, const uint64_t* const src) noexcept
+{
+	uint32_t count = 0;
+
+	for (std::size_t i = 0; i < roaring_bitmap_words; ++i)
+	{
+		dst[i] |= src[i];
+		count += static_cast<uint32_t>(bit14::popcount(dst[i]));
+	}
+
+	return count;
+}
+
+inline uint32_t bitmap_and(uint64_t* const dst, const uint64_t* const src) noexcept
+{
+	uint32_t count = 0;
+
+	for (std::size_t i = 0; i < roaring_bitmap_words; ++i)
+	{
+		dst[i] &= src[i];
+		count += static_cast<uint32_t>(bit14::popcount(dst[i]));
+	}
+
+	return count;
+}
+
+inline bool bitmap_test(const roaring_container& c, const uint16_t low) noexcept
+{
+	return (c.words[low / 64] >> (low % 64)) & 1;
+}
+
+template <typename F>
+void roaring_for_each(const roaring_container& c, const uint32_t high, F& f)
+{
+	switch (c.kind)
+	{
+	case roaring_kind::array:
+		for (const uint16_t low : c.values)
+			f(high | low);
+		break;
+
+	case roaring_kind::bitmap:
+		for (std::size_t i = 0; i < roaring_bitmap_words; ++i)
+		{
+			for (uint64_t word = c.words[i]; word != 0; word &= word - 1)
+				f(high | static_cast<uint32_t>(i * 64 + bit14::countr_zero(word)));
+		}
+		break;
+
+	case roaring_kind::run:
+		for (std::size_t i = 0; i < c.values.size(); i += 2)
+		{
+			const uint32_t last = uint32_t{ c.values[i] } + c.values[i + 1];
+
+			for (uint32_t low = c.values[i]; low <= last; ++low)
+				f(high | low);
+		}
+		break;
+	}
+}
+
+inline bool roaring_contains(const roaring_container& c, const uint16_t low) noexcept
+{
+	switch (c.kind)
+	{
+	case roaring_kind::array:
+		return std::binary_search(c.values.begin(), c.values.end(), low);
+
+	case roaring_kind::bitmap:
+		return bitmap_test(c, low);
+
+	case roaring_kind::run:
+	{
+		//Last run starting at or before low.
+		std::size_t first = 0;
+		std::size_t count = c.values.size() / 2;
+
+		while (count > 0)
+		{
+			const std::size_t half = count / 2;
+
+			if (c.values[2 * (first + half)] <= low)
+			{
+				first += half + 1;
+				count -= half + 1;
+			}
+			else
+				count = half;
+		}
+
+		return first > 0 && low - c.values[2 * (first - 1)] <= c.values[2 * (first - 1) + 1];
+	}
+	}
+
+	return false;
+}
+
+inline void roaring_to_bitmap(roaring_container& c)
+{
+	std::vector<uint64_t> words(roaring_bitmap_words, 0);
+	const auto set_bit = [&words](const uint32_t value) noexcept
+	{
+		words[(value & 0xFFFF) / 64] |= uint64_t{ 1 } << (value % 64);
+	};
+
+	roaring_for_each(c, 0, set_bit);
+	c.words = std::move(words);
+	c.values.clear();
+	c.values.shrink_to_fit();
+	c.kind = roaring_kind::bitmap;
+}
+
+inline void roaring_to_array(roaring_container& c)
+{
+	std::vector<uint16_t> values;
+	values.reserve(c.cardinality);
+	const auto push = [&values](const uint32_t value)
+	{
+		values.push_back(static_cast<uint16_t>(value));
+	};
+
+	roaring_for_each(c, 0, push);
+	c.values = std::move(values);
+	c.words.clear();
+	c.words.shrink_to_fit();
+	c.kind = roaring_kind::array;
+}
+
+//Picks array or bitmap by cardinality, run containers become one of the two.
+inline void roaring_normalize(roaring_container& c)
+{
+	if (c.cardinality <= roaring_array_max)
+	{
+		if (c.kind != roaring_kind::array)
+			roaring_to_array(c);
+	}
+	else if (c.kind != roaring_kind::bitmap)
+		roaring_to_bitmap(c);
+}
+
+//Number of maximal runs of consecutive values.
+inline std::size_t roaring_run_count(const roaring_container& c) noexcept
+{
+	std::size_t runs = 0;
+
+	switch (c.kind)
+	{
+	case roaring_kind::array:
+		for (std::size_t i = 0; i < c.values.size(); ++i)
+			runs += (i == 0 || c.values[i] != c.values[i - 1] + 1);
+		break;
+
+	case roaring_kind::bitmap:
+	{
+		uint64_t carry = 0;
+
+		//A run starts at every set bit whose lower neighbour is clear.
+		for (std::size_t i = 0; i < roaring_bitmap_words; ++i)
+		{
+			const uint64_t word = c.words[i];
+			runs += static_cast<std::size_t>(bit14::popcount(word & ~((word << 1) | carry)));
+			carry = word >> 63;
+		}
+		break;
+	}
+
+	case roaring_kind::run:
+		runs = c.values.size() / 2;
+		break;
+	}
+
+	return runs;
+}
+
+inline void roaring_to_runs(roaring_container& c)
+{
+	std::vector<uint16_t> runs;
+	runs.reserve(2 * roaring_run_count(c));
+	uint32_t previous = 0;
+	const auto extend = [&runs, &previous](const uint32_t value)
+	{
+		if (!runs.empty() && value == previous + 1)
+			++runs.back();
+		else
+		{
+			runs.push_back(static_cast<uint16_t>(value));
+			runs.push_back(0);
+		}
+
+		previous = value;
+	};
+
+	roaring_for_each(c, 0, extend);
+	c.values = std::move(runs);
+	c.words.clear();
+	c.words.shrink_to_fit();
+	c.kind = roaring_kind::run;
+}
+
+inline bool roaring_add(roaring_container& c, const uint16_t low)
+{
+	if (c.kind == roaring_kind::run)
+	{
+		if (roaring_contains(c, low))
+			return false;
+
+		roaring_normalize(c);
+	}
+
+	if (c.kind == roaring_kind::bitmap)
+	{
+		uint64_t& word = c.words[low / 64];
+		const uint64_t bit = uint64_t{ 1 } << (low % 64);
+
+		if (word & bit)
+			return false;
+
+		word |= bit;
+		++c.cardinality;
+		return true;
+	}
+
+	const auto position = std::lower_bound(c.values.begin(), c.values.end(), low);
+
+	if (position != c.values.end() && *position == low)
+		return false;
+
+	c.values.insert(position, low);
+	++c.cardinality;
+
+	if (c.cardinality > roaring_array_max)
+		roaring_to_bitmap(c);
+
+	return true;
+}
+
+inline bool roaring_remove(roaring_container& c, const uint16_t low)
+{
+	if (!roaring_contains(c, low))
+		return false;
+
+	if (c.kind == roaring_kind::run)
+		roaring_normalize(c);
+
+	--c.cardinality;
+
+	if (c.kind == roaring_kind::bitmap)
+	{
+		c.words[low / 64] &= ~(uint64_t{ 1 } << (low % 64));
+
+		if (c.cardinality <= roaring_array_max)
+			roaring_to_array(c);
+	}
+	else
+		c.values.erase(std::lower_bound(c.values.begin(), c.values.end(), low));
+
+	return true;
+}
+
+//Run containers take part in binary operations through an array or bitmap copy.
+inline const roaring_container& roaring_general(const roaring_container& c, roaring_container& scratch)
+{
+	if (c.kind != roaring_kind::run)
+		return c;
+
+	scratch = c;
+	roaring_normalize(scratch);
+	return scratch;
+}
+
+inline roaring_container roaring_and(const roaring_container& a, const roaring_container& b)
+{
+	roaring_container scratch_a;
+	roaring_container scratch_b;
+	const roaring_container& x = roaring_general(a, scratch_a);
+	const roaring_container& y = roaring_general(b, scratch_b);
+	roaring_container result{ roaring_kind::array, 0, {}, {} };
+
+	if (x.kind == roaring_kind::bitmap && y.kind == roaring_kind::bitmap)
+	{
+		result.kind = roaring_kind::bitmap;
+		result.words = x.words;
+		result.cardinality = bitmap_and(result.words.data(), y.words.data());
+
+		if (result.cardinality <= roaring_array_max)
+			roaring_to_array(result);
+	}
+	else if (x.kind == roaring_kind::array && y.kind == roaring_kind::array)
+	{
+		std::set_intersection(x.values.begin(), x.values.end(), y.values.begin(), y.values.end(),
+			std::back_inserter(result.values));
+		result.cardinality = static_cast<uint32_t>(result.values.size());
+	}
+	else
+	{
+		const roaring_container& array = (x.kind == roaring_kind::array) ? x : y;
+		const roaring_container& bitmap = (x.kind == roaring_kind::array) ? y : x;
+
+		for (const uint16_t low : array.values)
+		{
+			if (bitmap_test(bitmap, low))
+				result.values.push_back(low);
+		}
+
+		result.cardinality = static_cast<uint32_t>(result.values.size());
+	}
+
+	return result;
+}
+
+inline roaring_container roaring_or(const roaring_container& a, const roaring_container& b)
+{
+	roaring_container scratch_a;
+	roaring_container scratch_b;
+	const roaring_container& x = roaring_general(a, scratch_a);
+	const roaring_container& y = roaring_general(b, scratch_b);
+	roaring_container result{ roaring_kind::bitmap, 0, {}, {} };
+
+	if (x.kind == roaring_kind::array && y.kind == roaring_kind::array)
+	{
+		result.kind = roaring_kind::array;
+		result.values.reserve(x.values.size() + y.values.size());
+		std::set_union(x.values.begin(), x.values.end(), y.values.begin(), y.values.end(),
+			std::back_inserter(result.values));
+		result.cardinality = static_cast<uint32_t>(result.values.size());
+
+		if (result.cardinality > roaring_array_max)
+			roaring_to_bitmap(result);
+	}
+	else if (x.kind == roaring_kind::bitmap && y.kind == roaring_kind::bitmap)
+	{
+		result.words = x.words;
+		result.cardinality = bitmap_or(result.words.data(), y.words.data());
+	}
+	else
+	{
+		const roaring_container& array = (x.kind == roaring_kind::array) ? x : y;
+		const roaring_container& bitmap = (x.kind == roaring_kind::array) ? y : x;
+		result.words = bitmap.words;
+		result.cardinality = bitmap.cardinality;
+
+		for (const uint16_t low : array.values)
+		{
+			uint64_t& word = result.words[low / 64];
+			const uint64_t bit = uint64_t{ 1 } << (low % 64);
+			result.cardinality += !(word & bit);
+			word |= bit;
+		}
+	}
+
+	return result;
+}
+} //end namespace detail
+
+class roaring
+{
+public:
+	bool add(const uint32_t value)
+	{
+		const uint16_t key = static_cast<uint16_t>(value >> 16);
+		const std::size_t index = find(key);
+
+		if (index == m_keys.size() || m_keys[index] != key)
+		{
+			m_keys.insert(m_keys.begin() + index, key);
+			m_containers.insert(m_containers.begin() + index,
+				detail::roaring_container{ detail::roaring_kind::array, 0, {}, {} });
+		}
+
+		return detail::roaring_add(m_containers[index], static_cast<uint16_t>(value));
+	}
+
+	bool remove(const uint32_t value)
+	{
+		const uint16_t key = static_cast<uint16_t>(value >> 16);
+		const std::size_t index = find(key);
+
+		if (index == m_keys.size() || m_keys[index] != key)
+			return false;
+
+		if (!detail::roaring_remove(m_containers[index], static_cast<uint16_t>(value)))
+			return false;
+
+		if (m_containers[index].cardinality == 0)
+			erase_container(index);
+
+		return true;
+	}
+
+	bool contains(const uint32_t value) const noexcept
+	{
+		const uint16_t key = static_cast<uint16_t>(value >> 16);
+		const std::size_t index = find(key);
+		return index != m_keys.size() && m_keys[index] == key &&
+			detail::roaring_contains(m_containers[index], static_cast<uint16_t>(value));
+	}
+
+	uint64_t cardinality() const noexcept
+	{
+		uint64_t result = 0;
+
+		for (const detail::roaring_container& c : m_containers)
+			result += c.cardinality;
+
+		return result;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_keys.empty();
+	}
+
+	void clear() noexcept
+	{
+		m_keys.clear();
+		m_containers.clear();
+	}
+
+	//Turns every container into a run container when that is its smallest form.
+	void run_optimize()
+	{
+		for (detail::roaring_container& c : m_containers)
+		{
+			if (c.kind == detail::roaring_kind::run)
+				continue;
+
+			const std::size_t run_bytes = 4 * detail::roaring_run_count(c);
+			const std::size_t bytes = (c.kind == detail::roaring_kind::array) ?
+				2 * std::size_t{ c.cardinality } : 8 * detail::roaring_bitmap_words;
+
+			if (run_bytes < bytes)
+				detail::roaring_to_runs(c);
+		}
+	}
+
+	template <typename F>
+	void for_each(F&& f) const
+	{
+		for (std::size_t i = 0; i < m_keys.size(); ++i)
+			detail::roaring_for_each(m_containers[i], uint32_t{ m_keys[i] } << 16, f);
+	}
+
+	roaring& operator|=(const roaring& other)
+	{
+		roaring result;
+		std::size_t i = 0;
+		std::size_t j = 0;
+
+		while (i < m_keys.size() || j < other.m_keys.size())
+		{
+			if (j == other.m_keys.size() || (i < m_keys.size() && m_keys[i] < other.m_keys[j]))
+			{
+				result.m_keys.push_back(m_keys[i]);
+				result.m_containers.push_back(std::move(m_containers[i++]));
+			}
+			else if (i == m_keys.size() || other.m_keys[j] < m_keys[i])
+			{
+				result.m_keys.push_back(other.m_keys[j]);
+				result.m_containers.push_back(other.m_containers[j++]);
+			}
+			else
+			{
+				result.m_keys.push_back(m_keys[i]);
+				result.m_containers.push_back(detail::roaring_or(m_containers[i++], other.m_containers[j++]));
+			}
+		}
+
+		swap(result);
+		return *this;
+	}
+
+	roaring& operator&=(const roaring& other)
+	{
+		roaring result;
+		std::size_t i = 0;
+		std::size_t j = 0;
+
+		while (i < m_keys.size() && j < other.m_keys.size())
+		{
+			if (m_keys[i] < other.m_keys[j])
+				++i;
+			else if (other.m_keys[j] < m_keys[i])
+				++j;
+			else
+			{
+				detail::roaring_container c = detail::roaring_and(m_containers[i], other.m_containers[j]);
+
+				if (c.cardinality != 0)
+				{
+					result.m_keys.push_back(m_keys[i]);
+					result.m_containers.push_back(std::move(c));
+				}
+
+				++i;
+				++j;
+			}
+		}
+
+		swap(result);
+		return *this;
+	}
+
+	friend roaring operator|(roaring a, const roaring& b)
+	{
+		a |= b;
+		return a;
+	}
+
+	friend roaring operator&(roaring a, const roaring& b)
+	{
+		a &= b;
+		return a;
+	}
+
+	void swap(roaring& other) noexcept
+	{
+		m_keys.swap(other.m_keys);
+		m_containers.swap(other.m_containers);
+	}
+
+	std::vector<unsigned char> serialize() const
+	{
+		std::vector<unsigned char> out(4);
+		detail::store_le(out.data(), static_cast<uint32_t>(m_keys.size()));
+
+		for (std::size_t i = 0; i < m_keys.size(); ++i)
+		{
+			const detail::roaring_container& c = m_containers[i];
+			const bool is_run = (c.kind == detail::roaring_kind::run);
+			std::size_t position = out.size();
+			out.resize(position + header_size);
+			detail::store_le(&out[position], m_keys[i]);
+			out[position + 2] = static_cast<unsigned char>(c.kind);
+			detail::store_le(&out[position + 3], c.cardinality);
+			detail::store_le(&out[position + 7], static_cast<uint32_t>(is_run ? c.values.size() / 2 : 0));
+			position = out.size();
+
+			if (c.kind == detail::roaring_kind::bitmap)
+			{
+				out.resize(position + 8 * c.words.size());
+
+				for (const uint64_t word : c.words)
+				{
+					detail::store_le(&out[position], word);
+					position += 8;
+				}
+			}
+			else
+			{
+				out.resize(position + 2 * c.values.size());
+
+				for (const uint16_t value : c.values)
+				{
+					detail::store_le(&out[position], value);
+					position += 2;
+				}
+			}
+		}
+
+		return out;
+	}
+
+	bool deserialize(const unsigned char* const data, const std::size_t size)
+	{
+		clear();
+
+		if (!parse(data, size))
+		{
+			clear();
+			return false;
+		}
+
+		return true;
+	}
+
+private:
+	static constexpr std::size_t header_size = 11;
+
+	std::size_t find(const uint16_t key) const noexcept
+	{
+		return static_cast<std::size_t>(std::lower_bound(m_keys.begin(), m_keys.end(), key) - m_keys.begin());
+	}
+
+	void erase_container(const std::size_t index) noexcept
+	{
+		m_keys.erase(m_keys.begin() + index);
+		m_containers.erase(m_containers.begin() + index);
+	}
+
+	bool parse(const unsigned char* data, std::size_t size)
+	{
+		if (size < 4)
+			return false;
+
+		const uint32_t count = detail::load_le<uint32_t>(data);
+		data += 4;
+		size -= 4;
+
+		for (uint32_t n = 0; n < count; ++n)
+		{
+			if (size < header_size)
+				return false;
+
+			const uint16_t key = detail::load_le<uint16_t>(data);
+			const unsigned char kind = data[2];
+			const uint32_t cardinality = detail::load_le<uint32_t>(data + 3);
+			const uint32_t runs = detail::load_le<uint32_t>(data + 7);
+			data += header_size;
+			size -= header_size;
+
+			if ((!m_keys.empty() && key <= m_keys.back()) || kind > 2 || cardinality == 0 || cardinality > 65536)
+				return false;
+
+			detail::roaring_container c{ static_cast<detail::roaring_kind>(kind), cardinality, {}, {} };
+
+			if (c.kind == detail::roaring_kind::bitmap)
+			{
+				if (size < 8 * detail::roaring_bitmap_words)
+					return false;
+
+				uint32_t total = 0;
+				c.words.resize(detail::roaring_bitmap_words);
+
+				for (uint64_t& word : c.words)
+				{
+					word = detail::load_le<uint64_t>(data);
+					total += static_cast<uint32_t>(bit14::popcount(word));
+					data += 8;
+				}
+
+				size -= 8 * detail::roaring_bitmap_words;
+
+				if (total != cardinality || cardinality <= detail::roaring_array_max)
+					return false;
+			}
+			else
+			{
+				const std::size_t values = (c.kind == detail::roaring_kind::run) ? 2 * std::size_t{ runs } : cardinality;
+
+				if ((c.kind == detail::roaring_kind::array && cardinality > detail::roaring_array_max) ||
+					values > 2 * std::size_t{ 65536 } || size / 2 < values)
+					return false;
+
+				c.values.resize(values);
+
+				for (uint16_t& value : c.values)
+				{
+					value = detail::load_le<uint16_t>(data);
+					data += 2;
+				}
+
+				size -= 2 * values;
+
+				if (!valid_values(c))
+					return false;
+			}
+
+			m_keys.push_back(key);
+			m_containers.push_back(std::move(c));
+		}
+
+		return size == 0;
+	}
+
+	//Arrays must be strictly increasing, runs must be ordered, separated and add up to the cardinality.
+	static bool valid_values(const detail::roaring_container& c) noexcept
+	{
+		if (c.kind == detail::roaring_kind::array)
+		{
+			for (std::size_t i = 1; i < c.values.size(); ++i)
+			{
+				if (c.values[i] <= c.values[i - 1])
+					return false;
+			}
+
+			return true;
+		}
+
+		uint32_t total = 0;
+		uint32_t next_start = 0;
+
+		for (std::size_t i = 0; i < c.values.size(); i += 2)
+		{
+			const uint32_t start = c.values[i];
+			const uint32_t last = start + c.values[i + 1];
+
+			if ((i != 0 && start <= next_start) || last > 0xFFFF)
+				return false;
+
+			next_start = last + 1;
+			total += c.values[i + 1] + 1;
+		}
+
+		return total == c.cardinality;
+	}
+
+	std::vector<uint16_t> m_keys;
+	std::vector<detail::roaring_container> m_containers;
+};
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
@@ -0,0 +1,389 @@
+//bit14_timer_wheel.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	bit14::timer_wheel<T, SlotBits, Levels> is a hierarchical timing
+|||	wheel over integer ticks. Level l has 2^SlotBits slots, each one
+|||	2^(l * SlotBits) ticks wide, and a timer is filed at the highest
+|||	level where its deadline still differs from the current time.
+|||	Deadlines past the top level wait in an overflow list that is
+|||	refiled whenever the top level wraps.
+|||
+|||	Every level keeps a bit14::bit_priority_set of its non-empty slots,
+|||	so advance() jumps straight to the next occupied slot instead of
+|||	stepping tick by tick. A due slot is detached as a whole and its
+|||	timers are handed to the callback one after another, slots of
+|||	higher levels are cascaded down the same way.
+|||
+|||		timer_id schedule(uint64_t deadline, T payload);
+|||		bool cancel(timer_id id) noexcept;
+|||		template <typename F>
+|||		std::size_t advance(uint64_t now, F&& on_expire);	//calls on_expire(T&)
+|||		uint64_t next_event() const noexcept;
+|||		uint64_t now() const noexcept;
+|||		std::size_t size() const noexcept;
+|||		bool empty() const noexcept;
+|||
+|||	next_event() returns the tick at which advance() next has work to
+|||	do (a firing or a cascade), or no_event when no timer is pending.
+|||	Deadlines at or before now() fire on the next call to advance().
+|||	Timer ids stay unique, cancelling a fired timer returns false.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include <vector>			//vector
+#include <utility>			//move, forward
+#include "bit14.h"
+#include "bit14_priority_set.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+template <typename T, int SlotBits = 8, int Levels = 4>
+class timer_wheel
+{
+	static_assert(SlotBits > 0 && Levels > 0 && SlotBits * Levels <= 64,
+		"bit14::timer_wheel levels must cover at most 64 bits of ticks.\n");
+
+public:
+	using timer_id = uint64_t;
+
+	static constexpr timer_id invalid_timer = 0;
+	static constexpr uint64_t no_event = ~uint64_t{ 0 };
+	static constexpr std::size_t slots = std::size_t{ 1 } << SlotBits;
+
+	explicit timer_wheel(const uint64_t now = 0) : m_now(now), m_size(0), m_free(no_node)
+	{
+		for (uint32_t& head : m_heads)
+			head = no_node;
+	}
+
+	uint64_t now() const noexcept
+	{
+		return m_now;
+	}
+
+	std::size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	timer_id schedule(const uint64_t deadline, T payload)
+	{
+		uint32_t index = m_free;
+
+		if (index != no_node)
+		{
+			m_free = m_nodes[index].next;
+			m_nodes[index].payload = std::move(payload);
+		}
+		else
+		{
+			index = static_cast<uint32_t>(m_nodes.size());
+			m_nodes.push_back(node{ deadline, std::move(payload), no_node, no_node, 1, free_list });
+		}
+
+		node& timer = m_nodes[index];
+		timer.deadline = deadline;
+		link(index);
+		++m_size;
+		return (static_cast<uint64_t>(timer.generation) << 32) | index;
+	}
+
+	bool cancel(const timer_id id) noexcept
+	{
+		const uint32_t index = static_cast<uint32_t>(id);
+
+		if (index >= m_nodes.size())
+			return false;
+
+		node& timer = m_nodes[index];
+
+		if (timer.generation != static_cast<uint32_t>(id >> 32) || timer.list == free_list)
+			return false;
+
+		if (timer.list != detached_list)
+			unlink(index);
+
+		release_node(index);
+		--m_size;
+		return true;
+	}
+
+	uint64_t next_event() const noexcept
+	{
+		int level;
+		return find_next_event(level);
+	}
+
+	template <typename F>
+	std::size_t advance(const uint64_t now, F&& on_expire)
+	{
+		std::size_t fired = 0;
+
+		for (;;)
+		{
+			int level;
+			const uint64_t when = find_next_event(level);
+
+			if (when == no_event || when > now)
+				break;
+
+			m_now = when;
+
+			if (level == 0)
+				fired += expire_slot(slot_of(when, 0), on_expire);
+			else
+				cascade(level == Levels ? overflow_list : list_of(level, slot_of(when, level)));
+		}
+
+		if (now > m_now)
+			m_now = now;
+
+		return fired;
+	}
+
+private:
+	static constexpr uint32_t no_node = 0xFFFFFFFF;
+	static constexpr uint32_t overflow_list = static_cast<uint32_t>(Levels * slots);
+	static constexpr uint32_t detached_list = overflow_list + 1;
+	static constexpr uint32_t free_list = overflow_list + 2;
+
+	struct node
+	{
+		uint64_t deadline;
+		T payload;
+		uint32_t prev;
+		uint32_t next;
+		uint32_t generation;
+		uint32_t list;
+	};
+
+	static uint32_t list_of(const int level, const std::size_t slot) noexcept
+	{
+		return static_cast<uint32_t>(level * slots + slot);
+	}
+
+	static std::size_t slot_of(const uint64_t tick, const int level) noexcept
+	{
+		return static_cast<std::size_t>(tick >> (level * SlotBits)) & (slots - 1);
+	}
+
+	//First tick of the level span containing tick, each level spans 2^((level + 1) * SlotBits) ticks.
+	static uint64_t span_start(const uint64_t tick, const int level) noexcept
+	{
+		const int bits = (level + 1) * SlotBits;
+		return bits >= 64 ? 0 : (tick >> bits) << bits;
+	}
+
+	uint64_t find_next_event(int& level) const noexcept
+	{
+		uint64_t best = no_event;
+		level = 0;
+
+		if (m_heads[overflow_list] != no_node)
+		{
+			best = span_start(m_now, Levels - 1) + (uint64_t{ 1 } << (Levels * SlotBits - 1) << 1);
+			level = Levels;
+		}
+
+		//Higher levels win ties so a cascade runs before the slot it may refill.
+		for (int l = Levels - 1; l >= 0; --l)
+		{
+			const std::size_t current = slot_of(m_now, l);
+			const std::size_t slot = (l == 0) ? m_occupied[l].lower_bound(current) :
+				m_occupied[l].successor(current);
+
+			if (slot == bit_priority_set<slots>::npos)
+				continue;
+
+			const uint64_t when = span_start(m_now, l) + (static_cast<uint64_t>(slot) << (l * SlotBits));
+
+			if (when < best)
+			{
+				best = when;
+				level = l;
+			}
+		}
+
+		return best;
+	}
+
+	void release_node(const uint32_t index) noexcept
+	{
+		node& timer = m_nodes[index];
+		T discarded(std::move(timer.payload));
+		static_cast<void>(discarded);
+
+		timer.generation = (timer.generation == 0xFFFFFFFF) ? 1 : timer.generation + 1;
+		timer.list = free_list;
+		timer.next = m_free;
+		m_free = index;
+	}
+
+	void link(const uint32_t index) noexcept
+	{
+		node& timer = m_nodes[index];
+		const uint64_t deadline = timer.deadline > m_now ? timer.deadline : m_now;
+		const uint64_t diff = deadline ^ m_now;
+		const int level = (diff == 0) ? 0 : (bit14::bit_width(diff) - 1) / SlotBits;
+		uint32_t list = overflow_list;
+
+		if (level < Levels)
+		{
+			const std::size_t slot = slot_of(deadline, level);
+			list = list_of(level, slot);
+			m_occupied[level].insert(slot);
+		}
+
+		timer.list = list;
+		timer.prev = no_node;
+		timer.next = m_heads[list];
+
+		if (timer.next != no_node)
+			m_nodes[timer.next].prev = index;
+
+		m_heads[list] = index;
+	}
+
+	void unlink(const uint32_t index) noexcept
+	{
+		const node& timer = m_nodes[index];
+
+		if (timer.prev != no_node)
+			m_nodes[timer.prev].next = timer.next;
+		else
+			m_heads[timer.list] = timer.next;
+
+		if (timer.next != no_node)
+			m_nodes[timer.next].prev = timer.prev;
+
+		if (m_heads[timer.list] == no_node && timer.list < overflow_list)
+			m_occupied[timer.list / slots].erase(timer.list % slots);
+	}
+
+	uint32_t detach(const uint32_t list) noexcept
+	{
+		const uint32_t head = m_heads[list];
+		m_heads[list] = no_node;
+
+		if (list < overflow_list)
+			m_occupied[list / slots].erase(list % slots);
+
+		return head;
+	}
+
+	void cascade(const uint32_t list) noexcept
+	{
+		uint32_t index = detach(list);
+
+		while (index != no_node)
+		{
+			const uint32_t next = m_nodes[index].next;
+			link(index);
+			index = next;
+		}
+	}
+
+	//Callbacks may schedule or cancel timers, so the slot is detached into
+	//a batch of ids first and each id is checked again before it fires.
+	template <typename F>
+	std::size_t expire_slot(const std::size_t slot, F& on_expire)
+	{
+		uint32_t index = detach(list_of(0, slot));
+		m_batch.clear();
+
+		while (index != no_node)
+		{
+			node& timer = m_nodes[index];
+			timer.list = detached_list;
+			m_batch.push_back((static_cast<uint64_t>(timer.generation) << 32) | index);
+			index = timer.next;
+		}
+
+		std::size_t fired = 0;
+
+		for (std::size_t i = 0; i < m_batch.size(); ++i)
+		{
+			const uint32_t batch_index = static_cast<uint32_t>(m_batch[i]);
+			node& timer = m_nodes[batch_index];
+
+			if (timer.generation != static_cast<uint32_t>(m_batch[i] >> 32) || timer.list != detached_list)
+				continue;
+
+			T payload(std::move(timer.payload));
+			release_node(batch_index);
+			--m_size;
+			++fired;
+			on_expire(payload);
+		}
+
+		return fired;
+	}
+
+	uint64_t m_now;
+	std::size_t m_size;
+	uint32_t m_free;
+	uint32_t m_heads[Levels * slots + 1];
+	bit_priority_set<slots> m_occupied[Levels];
+	std::vector<node> m_nodes;
+	std::vector<uint64_t> m_batch;
+};
+
+template <typename T, int SlotBits, int Levels>
+constexpr typename timer_wheel<T, SlotBits, Levels>::timer_id timer_wheel<T, SlotBits, Levels>::invalid_timer;
+
+template <typename T, int SlotBits, int Levels>
+constexpr uint64_t timer_wheel<T, SlotBits, Levels>::no_event;
+
+template <typename T, int SlotBits, int Levels>
+constexpr std::size_t timer_wheel<T, SlotBits, Levels>::slots;
+
+template <typename T, int SlotBits, int Levels>
+constexpr uint32_t timer_wheel<T, SlotBits, Levels>::no_node;
+
+template <typename T, int SlotBits, int Levels>
+constexpr uint32_t timer_wheel<T, SlotBits, Levels>::overflow_list;
+
+template <typename T, int SlotBits, int Levels>
+constexpr uint32_t timer_wheel<T, SlotBits, Levels>::detached_list;
+
+template <typename T, int SlotBits, int Levels>
+constexpr uint32_t timer_wheel<T, SlotBits, Levels>::free_list;
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
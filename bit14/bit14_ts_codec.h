@@ -0,0 +1,347 @@
+//bit14_ts_codec.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	Gorilla style compression of (timestamp, double) samples into one
+|||	msb_first bit stream. The first sample is stored raw, every later
+|||	one as a timestamp code followed by a value code:
+|||
+|||	Timestamps store the delta of deltas d:
+|||		0				d == 0
+|||		10   + 7 bits	-63 <= d <= 64
+|||		110  + 9 bits	-255 <= d <= 256
+|||		1110 + 12 bits	-2047 <= d <= 2048
+|||		1111 + 64 bits	otherwise
+|||
+|||	Values store x, the bit14::bit_cast of the value XOR the previous
+|||	one, described by its bit14::countl_zero (capped at 31) and
+|||	bit14::countr_zero:
+|||		0						x == 0
+|||		10 + meaningful bits	x fits the previous leading / trailing window
+|||		11 + 5 bits leading + 6 bits length + meaningful bits
+|||
+|||		ts_encoder(void* data, std::size_t size) noexcept;
+|||		void append(int64_t timestamp, double value) noexcept;
+|||		std::size_t finish() noexcept;		//bytes written
+|||		std::size_t size() const noexcept;	//samples appended
+|||		bool overflow() const noexcept;
+|||
+|||		ts_decoder(const void* data, std::size_t size, std::size_t count) noexcept;
+|||		bool next(int64_t& timestamp, double& value) noexcept;
+|||		std::size_t decode(int64_t* timestamps, double* values, std::size_t n) noexcept;
+|||		std::size_t remaining() const noexcept;
+|||
+|||	The stream does not record its sample count, the decoder is given
+|||	the size() of the encoder. decode() fills up to n samples and takes
+|||	the samples that repeat the previous delta and value, the common
+|||	case for regular metrics, from a single 2 bit peek.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include "bit14.h"
+#include "bit14_bitstream.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+namespace detail
+{
+//Prefix length, payload bits and bias of the four short timestamp codes.
+struct ts_timestamp_code
+{
+	int prefix;
+	int bits;
+	int64_t bias;
+};
+
+constexpr ts_timestamp_code ts_timestamp_codes[4] = { { 1, 0, 0 }, { 2, 7, 63 }, { 3, 9, 255 }, { 4, 12, 2047 } };
+
+inline int64_t ts_wrapping_sub(const int64_t a, const int64_t b) noexcept
+{
+	return static_cast<int64_t>(static_cast<uint64_t>(a) - static_cast<uint64_t>(b));
+}
+
+inline int64_t ts_wrapping_add(const int64_t a, const int64_t b) noexcept
+{
+	return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+}
+} //end namespace detail
+
+class ts_encoder
+{
+public:
+	ts_encoder(void* data, const std::size_t size) noexcept
+		: m_out(data, size), m_count(0), m_time(0), m_delta(0), m_bits(0), m_leading(0), m_trailing(0),
+		m_has_window(false)
+	{
+	}
+
+	void append(const int64_t timestamp, const double value) noexcept
+	{
+		const uint64_t bits = bit14::bit_cast<uint64_t>(value);
+
+		if (m_count++ == 0)
+		{
+			m_out.write(static_cast<uint64_t>(timestamp), 64);
+			m_out.write(bits, 64);
+		}
+		else
+		{
+			write_timestamp(timestamp);
+			write_value(bits ^ m_bits);
+		}
+
+		m_time = timestamp;
+		m_bits = bits;
+	}
+
+	std::size_t finish() noexcept
+	{
+		return m_out.finish();
+	}
+
+	std::size_t size() const noexcept
+	{
+		return m_count;
+	}
+
+	bool overflow() const noexcept
+	{
+		return m_out.overflow();
+	}
+
+private:
+	void write_timestamp(const int64_t timestamp) noexcept
+	{
+		const int64_t delta = detail::ts_wrapping_sub(timestamp, m_time);
+		const int64_t dod = detail::ts_wrapping_sub(delta, m_delta);
+		m_delta = delta;
+
+		if (dod == 0)
+		{
+			m_out.write(0, 1);
+			return;
+		}
+
+		for (int code = 1; code < 4; ++code)
+		{
+			const detail::ts_timestamp_code& format = detail::ts_timestamp_codes[code];
+
+			if (dod >= -format.bias && dod <= format.bias + 1)
+			{
+				m_out.write((uint64_t{ 1 } << format.prefix) - 2, format.prefix);
+				m_out.write(static_cast<uint64_t>(dod + format.bias), format.bits);
+				return;
+			}
+		}
+
+		m_out.write(0xF, 4);
+		m_out.write(static_cast<uint64_t>(dod), 64);
+	}
+
+	void write_value(const uint64_t x) noexcept
+	{
+		if (x == 0)
+		{
+			m_out.write(0, 1);
+			return;
+		}
+
+		const int clz = bit14::countl_zero(x);
+		const int leading = clz > 31 ? 31 : clz;
+		const int trailing = bit14::countr_zero(x);
+
+		if (m_has_window && leading >= m_leading && trailing >= m_trailing)
+		{
+			m_out.write(0x2, 2);
+			m_out.write(x >> m_trailing, 64 - m_leading - m_trailing);
+			return;
+		}
+
+		const int length = 64 - leading - trailing;
+		m_out.write(0x3, 2);
+		m_out.write(static_cast<uint64_t>(leading), 5);
+		m_out.write(static_cast<uint64_t>(length & 63), 6);
+		m_out.write(x >> trailing, length);
+		m_leading = leading;
+		m_trailing = trailing;
+		m_has_window = true;
+	}
+
+	bit_writer<msb_first> m_out;
+	std::size_t m_count;
+	int64_t m_time;
+	int64_t m_delta;
+	uint64_t m_bits;
+	int m_leading;
+	int m_trailing;
+	bool m_has_window;
+};
+
+class ts_decoder
+{
+public:
+	ts_decoder(const void* data, const std::size_t size, const std::size_t count) noexcept
+		: m_in(data, size), m_remaining(count), m_first(true), m_time(0), m_delta(0), m_bits(0),
+		m_leading(0), m_trailing(0)
+	{
+	}
+
+	std::size_t remaining() const noexcept
+	{
+		return m_remaining;
+	}
+
+	bool next(int64_t& timestamp, double& value) noexcept
+	{
+		if (m_remaining == 0)
+			return false;
+
+		step();
+		timestamp = m_time;
+		value = bit14::bit_cast<double>(m_bits);
+		return true;
+	}
+
+	std::size_t decode(int64_t* timestamps, double* values, std::size_t n) noexcept
+	{
+		n = n < m_remaining ? n : m_remaining;
+
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			m_in.refill();
+
+			//Timestamp code 0 and value code 0: same delta, same value.
+			if (!m_first && m_in.peek(2) == 0)
+			{
+				m_in.consume(2);
+				m_time = detail::ts_wrapping_add(m_time, m_delta);
+				--m_remaining;
+			}
+			else
+			{
+				step();
+			}
+
+			timestamps[i] = m_time;
+			values[i] = bit14::bit_cast<double>(m_bits);
+		}
+
+		return n;
+	}
+
+private:
+	uint64_t read_bits(const int n) noexcept
+	{
+		if (n <= 56)
+			return m_in.read(n);
+
+		const uint64_t high = m_in.read(n - 32);
+		return (high << 32) | m_in.read(32);
+	}
+
+	void step() noexcept
+	{
+		--m_remaining;
+
+		if (m_first)
+		{
+			m_first = false;
+			m_time = static_cast<int64_t>(read_bits(64));
+			m_bits = read_bits(64);
+			return;
+		}
+
+		read_timestamp();
+		read_value();
+	}
+
+	void read_timestamp() noexcept
+	{
+		m_in.refill();
+		const int ones = bit14::countl_zero(~m_in.window());
+		int64_t dod;
+
+		if (ones < 4)
+		{
+			const detail::ts_timestamp_code& format = detail::ts_timestamp_codes[ones];
+			m_in.consume(format.prefix);
+			dod = static_cast<int64_t>(m_in.peek(format.bits)) - format.bias;
+			m_in.consume(format.bits);
+		}
+		else
+		{
+			m_in.consume(4);
+			dod = static_cast<int64_t>(read_bits(64));
+		}
+
+		m_delta = detail::ts_wrapping_add(m_delta, dod);
+		m_time = detail::ts_wrapping_add(m_time, m_delta);
+	}
+
+	void read_value() noexcept
+	{
+		m_in.refill();
+		const uint64_t control = m_in.peek(2);
+
+		if (control < 2)
+		{
+			m_in.consume(1);
+			return;
+		}
+
+		m_in.consume(2);
+
+		if (control == 3)
+		{
+			m_leading = static_cast<int>(m_in.peek(5));
+			m_in.consume(5);
+			const int length = static_cast<int>(m_in.peek(6));
+			m_in.consume(6);
+			m_trailing = 64 - m_leading - (length == 0 ? 64 : length);
+		}
+
+		m_bits ^= read_bits(64 - m_leading - m_trailing) << m_trailing;
+	}
+
+	bit_reader<msb_first> m_in;
+	std::size_t m_remaining;
+	bool m_first;
+	int64_t m_time;
+	int64_t m_delta;
+	uint64_t m_bits;
+	int m_leading;
+	int m_trailing;
+};
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
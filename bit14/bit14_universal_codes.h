@@ -0,0 +1,345 @@
+//bit14_universal_codes.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	Universal and Golomb style integer codes over bit14::bit_reader and
+|||	bit14::bit_writer, for either bit order:
+|||
+|||		Elias gamma		x >= 1: n = bit_width(x) - 1 zeros, a one,
+|||						then the low n bits of x
+|||		Elias delta		x >= 1: gamma(bit_width(x)), then the low
+|||						bit_width(x) - 1 bits of x
+|||		Rice(k)			x >= 0: x >> k zeros, a one, then the low
+|||						k bits of x
+|||		Exp-Golomb(k)	x >= 0: gamma(x + 2^k) without its first k
+|||						zeros, x + 2^k must not overflow
+|||
+|||	With msb_first the gamma code of x is the textbook one. Every code
+|||	starts with a unary prefix of zeros ended by a one, which decodes
+|||	with one bit14::countl_zero (msb_first) or bit14::countr_zero
+|||	(lsb_first) over the reader window. When the whole code fits in
+|||	the 56 buffered bits no further refill or branch on the prefix
+|||	is needed, longer codes fall back to a counting loop.
+|||
+|||		void write_gamma(bit_writer<Order>& out, uint64_t x) noexcept;
+|||		void write_delta(bit_writer<Order>& out, uint64_t x) noexcept;
+|||		void write_rice(bit_writer<Order>& out, uint64_t x, int k) noexcept;
+|||		void write_exp_golomb(bit_writer<Order>& out, uint64_t x, int k) noexcept;
+|||
+|||		uint64_t read_gamma(bit_reader<Order>& in) noexcept;
+|||		uint64_t read_delta(bit_reader<Order>& in) noexcept;
+|||		uint64_t read_rice(bit_reader<Order>& in, int k) noexcept;
+|||		uint64_t read_exp_golomb(bit_reader<Order>& in, int k) noexcept;
+|||
+|||	Each read function has a bulk overload taking uint64_t* out and
+|||	std::size_t n as its last arguments, which decodes n values and
+|||	keeps decoding from the same refill while codes fit. k ranges
+|||	over 0 to 63. Malformed input decodes to unspecified values and
+|||	never reads outside the buffer, see bit_reader::overrun().
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include "bit14.h"
+#include "bit14_bitstream.h"
+#include "bit14_preprocessor.h"
+
+namespace bit14
+{
+namespace detail
+{
+//Zeros in front of the next one bit of the window.
+inline int leading_zeros(const uint64_t window, lsb_first) noexcept
+{
+	return bit14::countr_zero(window);
+}
+
+inline int leading_zeros(const uint64_t window, msb_first) noexcept
+{
+	return bit14::countl_zero(window);
+}
+
+template <typename Order>
+int leading_zeros(const bit_reader<Order>& in) noexcept
+{
+	return detail::leading_zeros(in.window(), Order());
+}
+
+//Reads up to 64 bits, the first bit read is the most significant for msb_first.
+inline uint64_t read_wide(bit_reader<lsb_first>& in, const int n) noexcept
+{
+	if (n <= 56)
+		return in.read(n);
+
+	const uint64_t low = in.read(32);
+	return low | (in.read(n - 32) << 32);
+}
+
+inline uint64_t read_wide(bit_reader<msb_first>& in, const int n) noexcept
+{
+	if (n <= 56)
+		return in.read(n);
+
+	const uint64_t high = in.read(n - 32);
+	return (high << 32) | in.read(32);
+}
+
+//Counts and consumes the zeros of a unary prefix together with the closing one.
+template <typename Order>
+uint64_t read_unary(bit_reader<Order>& in) noexcept
+{
+	uint64_t zeros = 0;
+
+	for (;;)
+	{
+		in.refill();
+		const int z = detail::leading_zeros(in);
+
+		if (z < in.available())
+		{
+			in.consume(z + 1);
+			return zeros + static_cast<uint64_t>(z);
+		}
+
+		zeros += static_cast<uint64_t>(in.available());
+		in.consume(in.available());
+
+		if (in.overrun())
+			return zeros;
+	}
+}
+
+template <typename Order>
+void write_unary(bit_writer<Order>& out, uint64_t zeros) noexcept
+{
+	for (; zeros > 64; zeros -= 64)
+		out.write(0, 64);
+
+	out.write(0, static_cast<int>(zeros));
+	out.write(1, 1);
+}
+
+inline uint64_t low_bits(const uint64_t x, const int n) noexcept
+{
+	return n == 0 ? 0 : x & (~uint64_t{ 0 } >> (64 - n));
+}
+
+//Gamma code of a value with n bits below its leading one.
+template <typename Order>
+void write_gamma_bits(bit_writer<Order>& out, const uint64_t x, const int n) noexcept
+{
+	out.write(0, n);
+	out.write(1, 1);
+	out.write(detail::low_bits(x, n), n);
+}
+
+template <typename Order>
+uint64_t read_gamma_slow(bit_reader<Order>& in) noexcept
+{
+	const uint64_t n = detail::read_unary(in);
+
+	if (n > 63)
+		return 0;
+
+	return (uint64_t{ 1 } << n) | detail::read_wide(in, static_cast<int>(n));
+}
+} //end namespace detail
+
+template <typename Order>
+void write_gamma(bit_writer<Order>& out, const uint64_t x) noexcept
+{
+	assert(x != 0);
+	detail::write_gamma_bits(out, x, bit14::bit_width(x) - 1);
+}
+
+template <typename Order>
+void write_delta(bit_writer<Order>& out, const uint64_t x) noexcept
+{
+	assert(x != 0);
+	const int n = bit14::bit_width(x) - 1;
+	write_gamma(out, static_cast<uint64_t>(n) + 1);
+	out.write(detail::low_bits(x, n), n);
+}
+
+template <typename Order>
+void write_rice(bit_writer<Order>& out, const uint64_t x, const int k) noexcept
+{
+	detail::write_unary(out, x >> k);
+	out.write(detail::low_bits(x, k), k);
+}
+
+template <typename Order>
+void write_exp_golomb(bit_writer<Order>& out, const uint64_t x, const int k) noexcept
+{
+	const uint64_t shifted = x + (uint64_t{ 1 } << k);
+	const int n = bit14::bit_width(shifted) - 1;
+	out.write(0, n - k);
+	out.write(1, 1);
+	out.write(detail::low_bits(shifted, n), n);
+}
+
+template <typename Order>
+uint64_t read_gamma(bit_reader<Order>& in) noexcept
+{
+	in.refill();
+	const int z = detail::leading_zeros(in);
+
+	//2 * z + 1 bits, always buffered after a refill.
+	if (z <= 27)
+	{
+		in.consume(z + 1);
+		const uint64_t low = in.peek(z);
+		in.consume(z);
+		return (uint64_t{ 1 } << z) | low;
+	}
+
+	return detail::read_gamma_slow(in);
+}
+
+template <typename Order>
+uint64_t read_delta(bit_reader<Order>& in) noexcept
+{
+	const uint64_t n = read_gamma(in) - 1;
+
+	if (n > 63)
+		return 0;
+
+	return (uint64_t{ 1 } << n) | detail::read_wide(in, static_cast<int>(n));
+}
+
+template <typename Order>
+uint64_t read_rice(bit_reader<Order>& in, const int k) noexcept
+{
+	in.refill();
+	const int z = detail::leading_zeros(in);
+
+	if (z + 1 + k <= 56)
+	{
+		in.consume(z + 1);
+		const uint64_t low = in.peek(k);
+		in.consume(k);
+		return (static_cast<uint64_t>(z) << k) | low;
+	}
+
+	const uint64_t q = detail::read_unary(in);
+	return (q << k) | detail::read_wide(in, k);
+}
+
+template <typename Order>
+uint64_t read_exp_golomb(bit_reader<Order>& in, const int k) noexcept
+{
+	in.refill();
+	const int z = detail::leading_zeros(in);
+	const int n = z + k;
+
+	if (z + 1 + n <= 56)
+	{
+		in.consume(z + 1);
+		const uint64_t low = in.peek(n);
+		in.consume(n);
+		return ((uint64_t{ 1 } << n) | low) - (uint64_t{ 1 } << k);
+	}
+
+	const uint64_t prefix = detail::read_unary(in) + static_cast<uint64_t>(k);
+
+	if (prefix > 63)
+		return 0;
+
+	const int bits = static_cast<int>(prefix);
+	return ((uint64_t{ 1 } << bits) | detail::read_wide(in, bits)) - (uint64_t{ 1 } << k);
+}
+
+template <typename Order>
+void read_gamma(bit_reader<Order>& in, uint64_t* out, std::size_t n) noexcept
+{
+	while (n > 0)
+	{
+		in.refill();
+		int z = detail::leading_zeros(in);
+
+		if (2 * z + 1 > in.available())
+		{
+			*out++ = detail::read_gamma_slow(in);
+			--n;
+			continue;
+		}
+
+		do
+		{
+			in.consume(z + 1);
+			*out++ = (uint64_t{ 1 } << z) | in.peek(z);
+			in.consume(z);
+			z = detail::leading_zeros(in);
+		} while (--n > 0 && 2 * z + 1 <= in.available());
+	}
+}
+
+template <typename Order>
+void read_delta(bit_reader<Order>& in, uint64_t* out, std::size_t n) noexcept
+{
+	for (; n > 0; --n)
+		*out++ = read_delta(in);
+}
+
+template <typename Order>
+void read_rice(bit_reader<Order>& in, const int k, uint64_t* out, std::size_t n) noexcept
+{
+	while (n > 0)
+	{
+		in.refill();
+		int z = detail::leading_zeros(in);
+
+		if (z + 1 + k > in.available())
+		{
+			*out++ = read_rice(in, k);
+			--n;
+			continue;
+		}
+
+		do
+		{
+			in.consume(z + 1);
+			*out++ = (static_cast<uint64_t>(z) << k) | in.peek(k);
+			in.consume(k);
+			z = detail::leading_zeros(in);
+		} while (--n > 0 && z + 1 + k <= in.available());
+	}
+}
+
+template <typename Order>
+void read_exp_golomb(bit_reader<Order>& in, const int k, uint64_t* out, std::size_t n) noexcept
+{
+	for (; n > 0; --n)
+		*out++ = read_exp_golomb(in, k);
+}
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"
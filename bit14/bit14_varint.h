@@ -0,0 +1,335 @@
+//bit14_varint.h
+
+#pragma once
+
+/*=================================================================================
+===================================================================================
+|||	MIT License
+|||
+|||	Copyright (c) 2024, agrem44@gmail.com
+|||
+|||	Permission is hereby granted, free of charge, to any person obtaining a copy
+|||	of this software and associated documentation files (the "Software"), to deal
+|||	in the Software without restriction, including without limitation the rights
+|||	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+|||	copies of the Software, and to permit persons to whom the Software is
+|||	furnished to do so, subject to the following conditions:
+|||
+|||	The above copyright notice and this permission notice shall be included in all
+|||	copies or substantial portions of the Software.
+|||
+|||	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+|||	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+|||	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+|||	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+|||	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+|||	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+|||	SOFTWARE.
+===================================================================================
+===================================================================================*/
+
+/*=======================================================================
+=========================================================================
+|||	Variable length integer codecs.
+|||
+|||	LEB128 varints store 7 bits per byte, least significant group first,
+|||	with the high bit of every byte but the last set:
+|||
+|||		int varint_size(uint64_t value) noexcept;		//1 to 10 bytes
+|||		unsigned char* encode_varint(unsigned char* out, uint64_t value) noexcept;
+|||		const unsigned char* decode_varint(const unsigned char* first,
+|||			const unsigned char* last, uint64_t& value) noexcept;
+|||		uint64_t zigzag_encode(int64_t value) noexcept;
+|||		int64_t zigzag_decode(uint64_t value) noexcept;
+|||
+|||	varint_size() is (bit_width(value) + 6) / 7. decode_varint() loads
+|||	8 bytes at once when they are available, finds the last byte with
+|||	bit14::countr_zero over the clear continuation bits and gathers the
+|||	7 bit groups with three mask and shift steps (one pext with BMI2).
+|||	It returns nullptr for truncated input or values that do not fit
+|||	64 bits, otherwise the position after the varint.
+|||
+|||	Stream VByte stores 32 bit integers as 1 to 4 bytes each and keeps
+|||	the lengths apart in control bytes, 2 bits per integer, so that the
+|||	control byte of four integers selects a pshufb mask that expands
+|||	their data bytes in one step:
+|||
+|||		std::size_t streamvbyte_max_size(std::size_t n) noexcept;
+|||		std::size_t streamvbyte_encode(const uint32_t* in, std::size_t n, unsigned char* out) noexcept;
+|||		std::size_t streamvbyte_decode(const unsigned char* in, std::size_t size,
+|||			std::size_t n, uint32_t* out) noexcept;
+|||
+|||	The encoded form is (n + 3) / 4 control bytes followed by the data
+|||	bytes. Encode writes whole 32 bit words and needs an output buffer
+|||	of streamvbyte_max_size(n) bytes. Both functions return the number of encoded bytes, decode
+|||	returns 0 when size is too small for n integers. Decoding uses 16
+|||	byte SSSE3 or 32 byte AVX2 shuffles while at least that many bytes
+|||	of input remain and plain byte loads for the rest.
+=========================================================================
+=========================================================================*/
+
+#include <cstddef>			//size_t
+#include "bit14.h"
+#include "bit14_preprocessor.h"
+
+#if defined(BIT14_USING_SSSE3) || defined(BIT14_USING_AVX2) || defined(BIT14_USING_BMI2)
+#include <immintrin.h>
+#endif
+
+namespace bit14
+{
+inline int varint_size(const uint64_t value) noexcept
+{
+	return (bit14::bit_width(value | 1) + 6) / 7;
+}
+
+inline unsigned char* encode_varint(unsigned char* out, uint64_t value) noexcept
+{
+	while (value >= 0x80)
+	{
+		*out++ = static_cast<unsigned char>(value | 0x80);
+		value >>= 7;
+	}
+
+	*out++ = static_cast<unsigned char>(value);
+	return out;
+}
+
+namespace detail
+{
+//Packs the low 7 bits of every byte of word next to each other.
+inline uint64_t gather_varint_groups(const uint64_t word) noexcept
+{
+#ifdef BIT14_USING_BMI2
+	return _pext_u64(word, 0x7F7F7F7F7F7F7F7Full);
+#else
+	uint64_t groups = word & 0x7F7F7F7F7F7F7F7Full;
+	groups = (groups & 0x007F007F007F007Full) | ((groups & 0x7F007F007F007F00ull) >> 1);
+	groups = (groups & 0x00003FFF00003FFFull) | ((groups & 0x3FFF00003FFF0000ull) >> 2);
+	return (groups & 0x000000000FFFFFFFull) | ((groups & 0x0FFFFFFF00000000ull) >> 4);
+#endif
+}
+} //end namespace detail
+
+inline const unsigned char* decode_varint(const unsigned char* first, const unsigned char* const last,
+	uint64_t& value) noexcept
+{
+	if (last - first >= 8)
+	{
+		const uint64_t word = detail::load_le<uint64_t>(first);
+		const uint64_t stops = ~word & 0x8080808080808080ull;
+
+		if (stops)
+		{
+			const int bytes = (bit14::countr_zero(stops) >> 3) + 1;
+			const uint64_t kept = (bytes == 8) ? word : word & ((uint64_t{ 1 } << (8 * bytes)) - 1);
+			value = detail::gather_varint_groups(kept);
+			return first + bytes;
+		}
+
+		//Values of 57 bits or more continue into a 9th and 10th byte.
+		uint64_t result = detail::gather_varint_groups(word);
+		first += 8;
+
+		if (first == last)
+			return nullptr;
+
+		result |= static_cast<uint64_t>(*first & 0x7F) << 56;
+
+		if (*first++ < 0x80)
+		{
+			value = result;
+			return first;
+		}
+
+		if (first == last || *first > 1)
+			return nullptr;
+
+		value = result | (static_cast<uint64_t>(*first) << 63);
+		return first + 1;
+	}
+
+	uint64_t result = 0;
+
+	for (int shift = 0; first != last; shift += 7)
+	{
+		const unsigned char byte = *first++;
+		result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+		if (byte < 0x80)
+		{
+			value = result;
+			return first;
+		}
+	}
+
+	return nullptr;
+}
+
+inline uint64_t zigzag_encode(const int64_t value) noexcept
+{
+	return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzag_decode(const uint64_t value) noexcept
+{
+	return static_cast<int64_t>((value >> 1) ^ (uint64_t{ 0 } - (value & 1)));
+}
+
+namespace detail
+{
+//pshufb masks and data lengths for every control byte.
+struct streamvbyte_tables
+{
+	unsigned char shuffle[256][16];
+	unsigned char length[256];
+
+	constexpr streamvbyte_tables() : shuffle(), length()
+	{
+		for (int control = 0; control < 256; ++control)
+		{
+			int position = 0;
+
+			for (int i = 0; i < 4; ++i)
+			{
+				const int bytes = ((control >> (2 * i)) & 3) + 1;
+
+				for (int b = 0; b < 4; ++b)
+					shuffle[control][4 * i + b] = static_cast<unsigned char>(b < bytes ? position + b : 0xFF);
+
+				position += bytes;
+			}
+
+			length[control] = static_cast<unsigned char>(position);
+		}
+	}
+};
+
+inline const streamvbyte_tables& streamvbyte_table() noexcept
+{
+	static constexpr streamvbyte_tables tables{};
+	return tables;
+}
+
+inline int streamvbyte_code(const uint32_t value) noexcept
+{
+	return (bit14::bit_width(value | 1) - 1) >> 3;
+}
+
+inline const unsigned char* streamvbyte_decode_one(const unsigned char* data, const unsigned char* const end,
+	const int code, uint32_t& value) noexcept
+{
+	if (end - data >= 4)
+	{
+		value = detail::load_le<uint32_t>(data) & (0xFFFFFFFFu >> (24 - 8 * code));
+		return data + code + 1;
+	}
+
+	uint32_t result = 0;
+
+	for (int b = 0; b <= code; ++b)
+		result |= static_cast<uint32_t>(data[b]) << (8 * b);
+
+	value = result;
+	return data + code + 1;
+}
+} //end namespace detail
+
+inline std::size_t streamvbyte_max_size(const std::size_t n) noexcept
+{
+	return (n + 3) / 4 + 4 * n;
+}
+
+inline std::size_t streamvbyte_encode(const uint32_t* const in, const std::size_t n, unsigned char* const out) noexcept
+{
+	unsigned char* control = out;
+	unsigned char* data = out + (n + 3) / 4;
+
+	for (std::size_t i = 0; i < n; i += 4)
+	{
+		unsigned int bits = 0;
+		const std::size_t group = (n - i < 4) ? n - i : 4;
+
+		for (std::size_t j = 0; j < group; ++j)
+		{
+			const uint32_t value = in[i + j];
+			const int code = detail::streamvbyte_code(value);
+			bits |= static_cast<unsigned int>(code) << (2 * j);
+			detail::store_le(data, value);
+			data += code + 1;
+		}
+
+		*control++ = static_cast<unsigned char>(bits);
+	}
+
+	return static_cast<std::size_t>(data - out);
+}
+
+inline std::size_t streamvbyte_decode(const unsigned char* const in, const std::size_t size,
+	const std::size_t n, uint32_t* out) noexcept
+{
+	const std::size_t control_bytes = (n + 3) / 4;
+
+	if (size < control_bytes)
+		return 0;
+
+	const unsigned char* control = in;
+	const unsigned char* data = in + control_bytes;
+	const unsigned char* const end = in + size;
+
+#if defined(BIT14_USING_SSSE3)
+	const detail::streamvbyte_tables& table = detail::streamvbyte_table();
+	std::size_t groups = n / 4;
+#endif
+
+#if defined(BIT14_USING_AVX2)
+	for (; groups >= 2 && end - data >= 32; groups -= 2)
+	{
+		const unsigned char low = control[0];
+		const unsigned char high = control[1];
+		const __m256i bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(data))),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + table.length[low])), 1);
+		const __m256i mask = _mm256_inserti128_si256(_mm256_castsi128_si256(
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(table.shuffle[low]))),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(table.shuffle[high])), 1);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_shuffle_epi8(bytes, mask));
+		data += table.length[low] + table.length[high];
+		control += 2;
+		out += 8;
+	}
+#endif
+
+#if defined(BIT14_USING_SSSE3)
+	for (; groups > 0 && end - data >= 16; --groups)
+	{
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.shuffle[*control]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(bytes, mask));
+		data += table.length[*control++];
+		out += 4;
+	}
+#endif
+
+	for (std::size_t remaining = n - static_cast<std::size_t>(control - in) * 4; remaining > 0; ++control)
+	{
+		const std::size_t group = (remaining < 4) ? remaining : 4;
+
+		for (std::size_t j = 0; j < group; ++j)
+		{
+			const int code = (*control >> (2 * j)) & 3;
+
+			if (end - data < code + 1)
+				return 0;
+
+			data = detail::streamvbyte_decode_one(data, end, code, *out++);
+		}
+
+		remaining -= group;
+	}
+
+	return static_cast<std::size_t>(data - in);
+}
+} //end namespace bit14
+
+#include "bit14_preprocessor_cleanup.h"